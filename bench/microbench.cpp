@@ -0,0 +1,171 @@
+#include "matrix.h"
+#include "lp.h"
+#include "tabulate.hpp"
+#include "allocation_stats.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Microbenchmarks of the Matrix primitives and of a full simplex pivot, reporting the time, throughput and heap allocations of one
+// operation. Build with `make microbench` (and OPTIM_LEVEL=2 or 3, the default -O0 says little about the kernels):
+//
+//     ./bin/microbench [--sizes 16,64,256] [--min-time ms] [--filter name]
+
+namespace {
+
+typedef struct {
+    std::string name;
+    double flops;                       // floating point operations per op, 0 if the kernel only moves data
+    std::function<void()> setup;        // prepares the next op, outside of the measured time(may be empty)
+    std::function<void()> op;
+}Kernel;
+
+typedef struct {
+    double nsPerOp;
+    double bytesPerOp;
+    double allocationsPerOp;
+}KernelResult;
+
+// a rows x columns matrix of pseudo random values in [1, 2), so no kernel divides by 0
+Matrix randomMatrix(uint rows, uint columns, uint seed) {
+    std::vector<double> elements(rows * columns);
+    uint64_t state = seed * 0x9e3779b97f4a7c15ull + 1;
+    for(double& element : elements) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        element = 1 + (state >> 11) * 0x1.0p-53;
+    }
+    return Matrix(elements, rows, columns);
+}
+
+// runs `kernel` until `minTime` ms have been measured. Kernels without a setup are timed in growing batches, the others one op at a time
+KernelResult runKernel(const Kernel& kernel, double minTime) {
+    double elapsed = 0;
+    uint64_t ops = 0, bytes = 0, allocations = 0, batch = 1;
+
+    while(elapsed < minTime * 1e6) {
+        if(kernel.setup) kernel.setup();
+        uint64_t timedOps = kernel.setup ? 1 : batch;
+
+        // heap allocations are counted by the process wide operator new of allocation_stats
+        AllocationCounter counter;
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+        for(uint64_t k = 0; k < timedOps; k++) kernel.op();
+        auto end = std::chrono::steady_clock::now();
+        AllocationStats stats = counter.stop();
+
+        elapsed += std::chrono::duration<double, std::nano>(end - start).count();
+        bytes += stats.bytes;
+        allocations += stats.allocations;
+        ops += timedOps;
+        batch = std::min<uint64_t>(batch * 2, 1 << 16);
+    }
+
+    return {elapsed / ops, (double)bytes / ops, (double)allocations / ops};
+}
+
+std::vector<Kernel> getKernels(uint size, std::vector<Matrix>& data) {
+    // data[0], data[1]: size x size operands. data[2]: scratch copy. data[3], data[4]: row and column vectors.
+    // data[5..9]: simplex tableau, b, cb, zj and cj - zj of a size x size model with size slack variables. data[10], data[11]: scratch b and cb
+    data = {randomMatrix(size, size, 1), randomMatrix(size, size, 2), Matrix(), randomMatrix(1, size, 3), randomMatrix(size, 1, 4)};
+
+    Matrix tableau = randomMatrix(size, 2 * size, 5);
+    for(uint i = 0; i < size; i++) {
+        for(uint j = size; j < 2 * size; j++) tableau.setElement(i, j, (j - size == i) ? 1 : 0);
+    }
+    data.push_back(tableau);
+    data.push_back(randomMatrix(size, 1, 6));
+    data.push_back(zeros(size, 1));
+    data.push_back(zeros(1, 2 * size));
+    data.push_back(randomMatrix(1, 2 * size, 7));
+    data.push_back(Matrix());
+    data.push_back(Matrix());
+
+    double n = size;
+    Matrix* d = data.data();
+    std::vector<Kernel> kernels = {
+        {"operator*", 2 * n * n * n, nullptr, [d]() { Matrix product = d[0] * d[1]; }},
+        {"transpose", 0, nullptr, [d]() { Matrix transposed = d[0].transpose(); }},
+        {"stackVertical", 0, [d]() { d[2] = Matrix(d[0]); }, [d]() { d[2].stackVertical(d[1]); }},
+        {"stackHorizontal", 0, [d]() { d[2] = Matrix(d[0]); }, [d]() { d[2].stackHorizontal(d[1]); }},
+        {"removeColumn", 0, [d]() { d[2] = Matrix(d[0]); }, [d, size]() { d[2].removeColumn(size / 2); }},
+        {"getColumn", 0, nullptr, [d, size]() { Matrix column = d[0].getColumn(size / 2); }},
+        {"rowOperation", 2 * n, nullptr, [d, size]() { d[0].rowOperation(0, size - 1, 1e-12); }},
+        {"dotProduct", 2 * n, nullptr, [d]() { volatile double product = d[3].dotProduct(d[4]); (void)product; }},
+        // entering column, ratio test, then the elimination of the pivot column and the zj row(2 flops per tableau element each), as in
+        // LpProblem::solveSimplex
+        {"simplex pivot", 8 * n * n + 2 * n, [d]() { d[2] = Matrix(d[5]); d[10] = Matrix(d[6]); d[11] = Matrix(d[7]); }, [d, size]() {
+            uint pivotColumn = d[9].maxValueIndex();
+            Matrix column = d[2].getColumn(pivotColumn);
+            Matrix ratios = d[10].pointDivision(column);
+
+            uint pivotRow = 0;
+            for(uint i = 1; i < size; i++) {
+                if(ratios.getElement(i, 0) < ratios.getElement(pivotRow, 0)) pivotRow = i;
+            }
+            d[11].setElement(pivotRow, 0, d[9].getElement(0, pivotColumn));
+            LpProblem::pivotTableau(d[2], d[10], d[11], d[8], pivotRow, pivotColumn);
+        }},
+    };
+    return kernels;
+}
+
+std::vector<uint> parseSizes(const std::string& argument) {
+    std::vector<uint> sizes;
+    std::stringstream stream(argument);
+    std::string size;
+    while(std::getline(stream, size, ',')) sizes.push_back(std::stoul(size));
+    return sizes;
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::vector<uint> sizes = {16, 64, 256};
+    double minTime = 200;
+    std::string filter;
+
+    try {
+        for(int i = 1; i < argc; i++) {
+            std::string option = argv[i];
+            if(option == "--sizes" && i + 1 < argc) sizes = parseSizes(argv[++i]);
+            else if(option == "--min-time" && i + 1 < argc) minTime = std::stod(argv[++i]);
+            else if(option == "--filter" && i + 1 < argc) filter = argv[++i];
+            else throw std::invalid_argument("Invalid option: " + option);
+        }
+    }
+    catch(const std::exception& e) {
+        std::cerr << e.what() << "\nUsage: microbench [--sizes 16,64,256] [--min-time ms] [--filter name]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    tabulate::Table table;
+    table.add_row({"Kernel", "Size", "ns/op", "GFLOP/s", "Bytes allocated/op", "Allocations/op"});
+
+    for(uint size : sizes) {
+        if(size < 2) continue;
+
+        std::vector<Matrix> data;
+        for(const Kernel& kernel : getKernels(size, data)) {
+            if(!filter.empty() && kernel.name.find(filter) == std::string::npos) continue;
+
+            KernelResult result = runKernel(kernel, minTime);
+            std::ostringstream nsPerOp, gflops, bytesPerOp, allocationsPerOp;
+            nsPerOp << std::fixed << std::setprecision(1) << result.nsPerOp;
+            if(kernel.flops > 0) gflops << std::fixed << std::setprecision(3) << kernel.flops / result.nsPerOp;
+            else gflops << "-";
+            bytesPerOp << std::fixed << std::setprecision(0) << result.bytesPerOp;
+            allocationsPerOp << std::fixed << std::setprecision(1) << result.allocationsPerOp;
+
+            table.add_row({kernel.name, std::to_string(size), nsPerOp.str(), gflops.str(), bytesPerOp.str(), allocationsPerOp.str()});
+        }
+    }
+
+    std::cout << table << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#ifndef ALLOCATION_STATS_H
+#define ALLOCATION_STATS_H
+
+#include <cstdint>
+
+// heap allocations(through operator new) made while an AllocationCounter was running
+typedef struct {
+    uint64_t allocations;
+    uint64_t bytes;             // requested
+    uint64_t peakLiveBytes;     // highest growth of the live heap bytes over their amount when the counter was started
+    bool available;
+}AllocationStats;
+
+/**
+ * @brief Returns stats which aren't available(nothing was tracked)
+ */
+AllocationStats emptyAllocationStats();
+
+/**
+ * @brief Adds `stats` to `total`(the peak live bytes of both are the highest of them), making `total` available if `stats` is
+ */
+void addAllocationStats(AllocationStats& total, const AllocationStats& stats);
+
+// running counters which keep their own peak of the live heap bytes. Further counters running at the same time only report the growth of
+// the live bytes between their start and their stop as their peak
+#define ALLOCATION_COUNTER_SLOTS 64
+
+// counts the heap allocations of the whole process between `start` and `stop`. The replaced global operator new and operator delete only
+// track allocations while at least one counter is running, so an idle counter costs one relaxed atomic load per allocation. Counters
+// running at the same time(e.g. on several threads, or nested ones) see each other's allocations, but each keeps the peak of the live
+// heap bytes since its own start
+class AllocationCounter {
+    private:
+        uint64_t startAllocations;
+        uint64_t startBytes;
+        int64_t startLiveBytes;
+        int slot;                   // slot holding the counter's peak of the live bytes, -1 if every slot was taken
+        bool running;
+
+    public:
+        AllocationCounter();
+
+        /**
+         * @brief Stops the counter if it's still running
+         */
+        ~AllocationCounter();
+
+        AllocationCounter(const AllocationCounter&) = delete;
+        AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+        /**
+         * @brief Starts tracking allocations, from now on
+         */
+        void start();
+
+        /**
+         * @brief Stops tracking allocations and returns the ones made since `start`
+         */
+        AllocationStats stop();
+};
+
+#endif
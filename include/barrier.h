@@ -0,0 +1,121 @@
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include "lp.h"
+
+#include <vector>
+#include <utility>
+#include <sys/types.h>
+
+#define BARRIER_MAX_ITERATIONS 100
+#define BARRIER_TOLERANCE 1e-8
+#define BARRIER_STEP_FRACTION 0.995
+#define BARRIER_DIVERGENCE 1e12
+// largest relative difference between the objective function values of the crossover solution and of the barrier solution
+#define BARRIER_CROSSOVER_TOLERANCE 1e-6
+
+class BarrierSolver {
+    private:
+        uint nRows, nColumns, nStructural;
+
+        // the model in standard form(min c*x, A*x = b, x >= 0), with A stored by columns and by rows
+        std::vector<std::vector<std::pair<uint, double>>> columns;
+        std::vector<std::vector<std::pair<uint, double>>> rows;
+        std::vector<double> b, c;
+
+        // primal variables, dual variables and reduced costs
+        std::vector<double> x, y, s;
+
+        // sparse Cholesky factor of the normal equations matrix in a fill reducing order(P*A*D*A^T*P^T = L*L^T). The order and the
+        // pattern of L only depend on the pattern of A, so they're computed once, and each factorization only computes the values
+        std::vector<uint> eliminationOrder;     // row of A eliminated at each step(P)
+        std::vector<uint> eliminationStep;      // step at which each row of A is eliminated(P^-1)
+        std::vector<uint> factorStart;          // column k of L is [factorStart[k], factorStart[k + 1]) of factorRows and factorValues,
+        std::vector<uint> factorRows;           // starting with its diagonal, followed by increasing rows
+        std::vector<double> factorValues;
+        std::vector<bool> droppedPivots;
+
+        uint iterations;
+        const std::atomic<bool>* cancelFlag;
+
+        /**
+         * @brief Converts `problem` into standard form, adding a slack or surplus variable to each inequality constraint
+         */
+        void buildStandardForm(LpProblem& problem);
+
+        /**
+         * @brief Returns A*v
+         */
+        std::vector<double> multiplyA(const std::vector<double>& v);
+
+        /**
+         * @brief Returns A^T*v
+         */
+        std::vector<double> multiplyATranspose(const std::vector<double>& v);
+
+        /**
+         * @brief Computes a minimum degree order of the rows of A*A^T, by eliminating them one at a time from its graph, and the pattern
+         *        of the Cholesky factor, which is the fill graph's neighborhood of each eliminated row
+         */
+        void analyzeNormalMatrix();
+
+        /**
+         * @brief Computes the Cholesky factorization of A*D*A^T, with D = diag(`d`), on the pattern found by `analyzeNormalMatrix`. Pivots that are too small(caused by
+         *        linearly dependent constraints) are dropped, which makes the corresponding component of every solution 0
+         */
+        void factorNormalMatrix(const std::vector<double>& d);
+
+        /**
+         * @brief Solves (A*D*A^T)*v = `rhs` using the last factorization
+         */
+        std::vector<double> solveNormalEquations(const std::vector<double>& rhs);
+
+        /**
+         * @brief Computes Mehrotra's starting point, a solution of the least squares problems shifted into the positive orthant
+         */
+        void initialPoint();
+
+        /**
+         * @brief Solves the Newton system for the search direction, given the primal, dual and complementarity residuals
+         */
+        void searchDirection(const std::vector<double>& rp, const std::vector<double>& rd, const std::vector<double>& rc,
+                             std::vector<double>& dx, std::vector<double>& dy, std::vector<double>& ds);
+
+        /**
+         * @brief Returns the largest step that keeps `v` + step * `dv` non negative(INFINITY if `dv` is non negative)
+         */
+        double maxStepLength(const std::vector<double>& v, const std::vector<double>& dv);
+
+    public:
+        /**
+         * @brief Builds a barrier solver for the LP relaxation of `problem`. The variables' bounds are ignored(they must be
+         *        turned into constraints beforehand), so every variable is only required to be non negative. The solver stops early
+         *        if the problem's cancel flag is set
+         */
+        BarrierSolver(LpProblem& problem);
+
+        /**
+         * @brief Runs Mehrotra's predictor-corrector method until the primal and dual residuals and the duality gap are within BARRIER_TOLERANCE
+         *
+         * @return CONTINUOUS_SOLUTION if the method converged, NOT_YET_SOLVED if it didn't(the iterates diverged, which happens for infeasible
+         *         and unbounded models, BARRIER_MAX_ITERATIONS was reached, or the solve was cancelled). In the second case the problem should be solved with the simplex method
+         */
+        ProblemStatus solve();
+
+        /**
+         * @brief Returns the values of the problem's variables at the last iterate
+         */
+        std::vector<double> getSolution();
+
+        /**
+         * @brief Returns the reduced costs of the problem's variables at the last iterate(in the minimization sense)
+         */
+        std::vector<double> getReducedCosts();
+
+        /**
+         * @brief Returns the number of interior point iterations of the last solve
+         */
+        uint getIterations() { return iterations; }
+};
+
+#endif
@@ -17,6 +17,7 @@ class BaBNode {
         BaBNode* rightChild;
         NodeStatus status;
         uint depth;
+        uint id;
     public:
         BaBNode(void) = default;
 
@@ -102,6 +103,13 @@ class BaBNode {
          * @brief Return the node's `depth`
          */
         uint getDepth() { return depth; }
+
+        /**
+         * @brief Sets the node's `id`(the index of its record in the tree's node log)
+         */
+        void setId(uint newId) { id = newId; }
+
+        uint getId() { return id; }
 };
 
 #endif
\ No newline at end of file
@@ -3,19 +3,127 @@
 
 #include "bb_node.h"
 #include "bb_utils.h"
+#include "presolve.h"
+#include "shared_incumbent.h"
+#include "result_cache.h"
+#include "model_hash.h"
+#include "perf_counters.h"
+#include "allocation_stats.h"
+#include "node_log.h"
+#include "progress.h"
+
+#include <chrono>
+#include <memory>
 
 class BaBTree {
     private:
         BaBNode* headNode;
+        LpProblem originalProblem;
+        std::shared_ptr<PostsolveStack> postsolveStack;
+        ProblemStatus rootStatus;
+        ProblemStatus treeStatus;
+        bool scaling;
+        LpAlgorithm rootAlgorithm;
+        bool crossover;
+        bool concurrentRoot;
+        std::shared_ptr<SharedIncumbent> sharedIncumbent;
+        std::string dumpDirectory;
+        std::string dumpExtension;
+        std::shared_ptr<ResultCache> resultCache;
+        ModelFingerprint modelFingerprint;
+        std::string resultKey;
+        bool cachedResult;
+        double cachedExecutionTime;     // ms the cached result took to solve, when it was stored
+        bool collectPerfCounters;
+        std::shared_ptr<PerfCounters> perfCounters;     // open while the tree is solved
+        std::string perfCountersError;
+        bool trackAllocations;
+        std::shared_ptr<AllocationCounter> allocationCounter;   // running while the tree is solved
+        SolvePhase currentPhase;
+        bool recordNodes;
+        std::vector<NodeRecord> nodeRecords;
+        std::shared_ptr<ProgressReporter> progressReporter;
         PerformanceMetrics metrics;
 
+        /**
+         * @brief Returns the result cache key of solving the original problem with the given strategies and the tree's settings:
+         *        the key of the problem's fingerprint, the solver's version and every setting that changes how the problem is solved
+         */
+        std::string getResultKey(ExplorationStrategy explorationStrat, BranchingStrategy branchingStrat);
+
+        /**
+         * @brief Writes `problem` to `dumpDirectory`/`name``dumpExtension`, if model dumps are enabled
+         */
+        void dumpModel(LpProblem& problem, const std::string& name);
+
+        /**
+         * @brief Ends the current solve phase(adding its performance counters and allocations to those of the phase) and starts `phase`.
+         *        N_SOLVE_PHASES ends the current phase without starting another. Does nothing unless performance counters are collected or
+         *        allocations are tracked
+         */
+        void switchPhase(SolvePhase phase);
+
+        /**
+         * @brief Presolves the original problem once, and creates the head node(or root node) with the reduced problem. Every other node
+         *        derives from it, so the whole tree works in the reduced variables, and shares the same postsolve stack
+         */
+        void presolveRoot();
+
+        /**
+         * @brief Solves the head node's LP relaxation with every available LP algorithm at the same time, each on its own thread.
+         *        The first one to finish wins, and the others are cancelled. The winner is recorded in the metrics
+         */
+        void solveRootConcurrently();
+
+        /**
+         * @brief Maps the solution of `node` back to the original problem's variables
+         */
+        Matrix getOriginalSolution(BaBNode* node);
+
+        /**
+         * @brief Fills in the performance metrics and maps the incumbent solution back to the original problem's variables
+         */
+        Matrix finishSearch(BaBNode* incumbentSolution, uint solvedNodes, std::chrono::steady_clock::time_point start);
+
+        /**
+         * @brief Adds the record of `node`, created by branching on `parent`(NULL for the head node), and gives `node` its id. Does nothing
+         *        unless nodes are recorded
+         */
+        void recordNewNode(BaBNode* node, BaBNode* parent, NodeDirection direction);
+
+        /**
+         * @brief Fills in the record of `node`, whose LP relaxation was just solved in `solveTime` ms. Does nothing unless nodes are recorded
+         */
+        void recordSolvedNode(BaBNode* node, double solveTime);
+
+        /**
+         * @brief Sets the fate of `node`'s record. Does nothing unless nodes are recorded
+         */
+        void recordFate(BaBNode* node, NodeFate fate);
+
+        /**
+         * @brief Solves the LP relaxation of `node`, tracing and recording it
+         */
+        void solveNode(BaBNode* node, uint number);
+
+        /**
+         * @brief Branches on `node`(whose LP solution isn't integral) with `branchingStrat`, adding both children to `nodeQueue`
+         */
+        void branchNode(BaBNode* node, BranchingStrategy branchingStrat, std::vector<BaBNode*>& nodeQueue);
+
+        /**
+         * @brief Publishes the state of the search to the progress reporter. The open nodes which aren't solved yet are the children of
+         *        `lastBranched`, whose bound is theirs
+         */
+        void publishProgress(const std::vector<BaBNode*>& nodeQueue, BaBNode* incumbentSolution, BaBNode* lastBranched, uint solvedNodes);
+
         /**
          * @brief Fathoms(cuts) all necessary leaf nodes and updates `incumbentSolution` if necessary
          */
         void fathomLeafNodes(std::vector<BaBNode*>& nodeQueue, ExplorationStrategy strategy, BaBNode*& incumbentSolution);
 
         /**
-         * @brief Updates `incumbentSolution` if `candidate` has a better objective function value
+         * @brief Updates `incumbentSolution` if `candidate` has a better objective function value, and offers it to the shared incumbent
          */
         void updateIncumbentSolution(BaBNode* candidate, BaBNode*& incumbentSolution);
 
@@ -30,19 +138,113 @@ class BaBTree {
          */
         void sortNodeQueue(std::vector<BaBNode*>& nodeQueue, ExplorationStrategy strategy);
 
+        /**
+         * @brief Displays the allocations, allocated bytes and peak live heap bytes of every measured phase, and the peak resident memory
+         */
+        void displayAllocationStats();
+
+        /**
+         * @brief Displays the performance counters of every measured phase(n/a for events which couldn't be counted), with the instructions
+         *        per cycle, and why events are missing
+         */
+        void displayPerfCounters();
+
     public:
         /**
-         * @brief Standard constructor. Allocates memory and initializes the head node(or root node) of the tree with `initialProblem`
+         * @brief Standard constructor. Stores `initialProblem`, which is presolved when the tree is solved
          */
         BaBTree(LpProblem initialProblem);
 
+        /**
+         * @brief Enables or disables scaling of the nodes' LP problems(enabled by default)
+         */
+        void setScaling(bool enabled) { scaling = enabled; }
+
+        /**
+         * @brief Sets the algorithm used to solve the root node's LP relaxation(SIMPLEX by default). Every other node is solved
+         *        with the simplex method
+         */
+        void setRootAlgorithm(LpAlgorithm algorithm, bool useCrossover = true) { rootAlgorithm = algorithm; crossover = useCrossover; }
+
+        /**
+         * @brief Enables or disables racing the LP algorithms on the root node's LP relaxation(disabled by default). When enabled,
+         *        the root algorithm set with `setRootAlgorithm` is ignored
+         */
+        void setConcurrentRoot(bool enabled) { concurrentRoot = enabled; }
+
+        /**
+         * @brief Shares the incumbent with other trees solving the same problem(on other threads): nodes are also fathomed using the
+         *        other trees' solutions, and the search stops as soon as `incumbent` is asked to stop
+         */
+        void setSharedIncumbent(std::shared_ptr<SharedIncumbent> incumbent) { sharedIncumbent = incumbent; }
+
+        /**
+         * @brief Sets the cache `solveTree` looks its result up in before solving, and stores its result in after solving. Pass NULL to
+         *        disable it(the default)
+         */
+        void setResultCache(std::shared_ptr<ResultCache> cache) { resultCache = cache; }
+
+        /**
+         * @brief Enables or disables collecting the performance counters(see PerfCounters) of the presolve, root LP and tree search phases
+         *        into the metrics(disabled by default). Events the system can't count are left unavailable
+         */
+        void setPerfCounters(bool enabled) { collectPerfCounters = enabled; }
+
+        /**
+         * @brief Records the performance counters of a phase measured outside the tree(e.g. PARSE_PHASE), so they're reported with the others
+         */
+        void setPhaseCounters(SolvePhase phase, const PerfCounts& counts) { metrics.phase_counters[phase] = counts; }
+
+        /**
+         * @brief Enables or disables tracking the heap allocations(see AllocationCounter) of the presolve, root LP, node LP and tree search
+         *        phases, and the peak resident memory, into the metrics(disabled by default). Trees tracking their allocations mustn't be
+         *        solved at the same time as other trees, whose allocations they would count
+         */
+        void setAllocationTracking(bool enabled) { trackAllocations = enabled; }
+
+        /**
+         * @brief Records the allocations of a phase measured outside the tree(e.g. PARSE_PHASE), so they're reported with the others
+         */
+        void setPhaseAllocations(SolvePhase phase, const AllocationStats& stats) { metrics.phase_allocations[phase] = stats; }
+
+        /**
+         * @brief Enables or disables recording every node of the search tree(see NodeRecord: depth, bound, LP iterations, solve time,
+         *        fractional variables, branching variable and fate) while it's solved(disabled by default). Records are kept in memory,
+         *        and can be written with NodeLog once the tree is solved
+         */
+        void setNodeRecording(bool enabled) { recordNodes = enabled; }
+
+        /**
+         * @brief Returns the records of the nodes of the last `solveTree`, indexed by node id(empty unless nodes are recorded, or if the
+         *        result was read from the result cache)
+         */
+        const std::vector<NodeRecord>& getNodeRecords() { return nodeRecords; }
+
+        /**
+         * @brief Sets the reporter the search publishes its state to whenever the reporter asks for it. Pass NULL to disable it(the default)
+         */
+        void setProgressReporter(std::shared_ptr<ProgressReporter> reporter) { progressReporter = reporter; }
+
+        /**
+         * @brief Checks if the last `solveTree` result was read from the result cache
+         */
+        bool isCachedResult() { return cachedResult; }
+
+        /**
+         * @brief Enables model dumps: the presolved model is written to `directory`/presolved`extension`, and every node's LP model(with its
+         *        branching bounds) to `directory`/node_<number>`extension` before it's solved, so that the LP model of a node which takes
+         *        too long is already on disk. `extension` is .lp or .mps(see ModelFileWriter). An empty `directory` disables the dumps
+         */
+        void setModelDump(const std::string& directory, const std::string& extension = ".lp") { dumpDirectory = directory; dumpExtension = extension; }
+
         /**
          * @brief Given an exploration strategy and a branching strategy, solve the IP model using the Branch and Bound method
          */
         Matrix solveTree(ExplorationStrategy explorationStrat, BranchingStrategy branchingStrat);
 
         /**
-         * @brief Displays the `optimalWholeSolution` to the IP model, along with a few performance metrics
+         * @brief Displays the `optimalWholeSolution` to the IP model, along with a few performance metrics. The nodes and LP iterations of
+         *        a cached result are those of the solve that stored it, and are labeled as such
          */
         void displayProblem(Matrix optimalWholeSolution);
 
@@ -52,6 +254,11 @@ class BaBTree {
         void deleteTree();
 
         PerformanceMetrics getMetrics();
+
+        /**
+         * @brief Returns the status of the IP model after solving the tree(WHOLE_SOLUTION, INFEASIBLE or UNBOUNDED)
+         */
+        ProblemStatus getStatus() { return treeStatus; }
 };
 
 #endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define BB_UTILS_H
 
 #include "matrix.h"
+#include "lp.h"
+#include "perf_counters.h"
+#include "allocation_stats.h"
 #include <sys/types.h>
 #include <vector>
 #include <string>
@@ -21,11 +24,26 @@ enum class ExplorationStrategy {
     RANDOM_NODE,
 };
 
+// phases of a solve which are measured separately. N_SOLVE_PHASES also stands for no phase
+enum SolvePhase {
+    PARSE_PHASE,
+    PRESOLVE_PHASE,
+    ROOT_LP_PHASE,
+    NODE_LP_PHASE,          // LP relaxations of every node but the root
+    TREE_SEARCH_PHASE,      // the rest of the search(branching, fathoming, sorting the node queue, ...)
+    N_SOLVE_PHASES,
+};
+
 typedef struct {
     uint explored_nodes;
     double execution_time;
     Matrix optimalWholeSolution;
     uint optimalSolutionDepth;
+    uint lp_iterations;
+    LpAlgorithm root_algorithm;
+    PerfCounts phase_counters[N_SOLVE_PHASES];             // only available when performance counters are collected
+    AllocationStats phase_allocations[N_SOLVE_PHASES];      // only available when allocations are tracked
+    size_t peak_resident_memory;                            // KB, 0 unless allocations are tracked
 }PerformanceMetrics;
 
 /**
@@ -39,5 +57,18 @@ std::vector<BranchingStrategy> getPossibleBranchingStrategies();
 
 std::string convertExplorStratToString(ExplorationStrategy strat);
 std::string convertBranchStratToString(BranchingStrategy strat);
+std::string convertLpAlgorithmToString(LpAlgorithm algorithm);
+std::string convertProblemStatusToString(ProblemStatus status);
+std::string convertSolvePhaseToString(SolvePhase phase);
+
+/**
+ * @throw std::invalid_argument - if `name` isn't the name of an exploration strategy
+ */
+ExplorationStrategy convertStringToExplorStrat(const std::string& name);
+
+/**
+ * @throw std::invalid_argument - if `name` isn't the name of a branching strategy
+ */
+BranchingStrategy convertStringToBranchStrat(const std::string& name);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef BINARY_MODEL_H
+#define BINARY_MODEL_H
+
+#include "sparse_model.h"
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+#define BINARY_MODEL_MAGIC "BBMODEL"
+#define BINARY_MODEL_VERSION 1
+#define BINARY_MODEL_EXTENSION ".bbm"
+
+// identifies the version of the source file a binary model was built from
+typedef struct {
+    uint64_t size;
+    int64_t modified;
+}ModelSourceStamp;
+
+// fixed size header at the start of every binary model file. It's followed by the payload: the objective, the bounds, the right hand
+// sides, the ranges and the matrix values(doubles), the column starts and row indexes of the matrix(uint32), the row types and
+// integer flags(one byte each), and finally the lengths(uint32) and characters of the model, row and column names
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t type;
+    ModelSourceStamp source;
+    uint64_t contentHash;
+    uint64_t payloadSize;
+    uint32_t nRows;
+    uint32_t nColumns;
+    uint64_t nNonzeros;
+    double objectiveOffset;
+}BinaryModelHeader;
+
+class BinaryModel {
+    private:
+        /**
+         * @brief Returns a 64 bit hash of `data`, consuming it 8 bytes at a time
+         */
+        static uint64_t hash(std::string_view data);
+
+        /**
+         * @brief Checks that `contents` starts with a header of the current version whose payload is complete, and returns it
+         *
+         * @throw std::invalid_argument - if it doesn't
+         */
+        static BinaryModelHeader readHeader(std::string_view contents);
+
+    public:
+        /**
+         * @brief Returns the stamp(size and modification time) of the file whose name is `fileName`
+         *
+         * @throw std::invalid_argument - if the file doesn't exist
+         */
+        static ModelSourceStamp getSourceStamp(const std::string& fileName);
+
+        /**
+         * @brief Writes `model` to the binary model file whose name is `fileName`, recording `source` as the stamp of the file the model was
+         *        read from. The file is written under a temporary name and then renamed, so readers never see a partial file
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        static void write(const SparseModel& model, const std::string& fileName, ModelSourceStamp source);
+
+        /**
+         * @brief Checks if `contents`(e.g. a mapped binary model file) is a valid binary model built from the source file version `source`
+         */
+        static bool isUpToDate(std::string_view contents, ModelSourceStamp source);
+
+        /**
+         * @brief Reads the model stored in `contents`, verifying its content hash
+         *
+         * @throw std::invalid_argument - if `contents` isn't a valid binary model, or its content hash doesn't match
+         */
+        static SparseModel read(std::string_view contents);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+
+#define WRITE_BUFFER_SIZE (1 << 16)
+
+class BufferedWriter {
+    private:
+        std::string fileName;
+        int fileDescriptor;
+        char buffer[WRITE_BUFFER_SIZE];
+        size_t used;
+
+        /**
+         * @brief Writes `size` bytes of `data` to the file, retrying interrupted and partial writes
+         *
+         * @throw std::invalid_argument - if the write fails
+         */
+        void writeAll(const char* data, size_t size);
+
+        /**
+         * @brief Writes the buffered output to the file and empties the buffer
+         *
+         * @throw std::invalid_argument - if the write fails
+         */
+        void flush();
+
+    public:
+        /**
+         * @brief Creates(or truncates) the file whose name is `fileName` for writing. Output is only written to the file in
+         *        WRITE_BUFFER_SIZE blocks, so writing many small pieces doesn't cost a system call each
+         *
+         * @throw std::invalid_argument - if the file can't be created
+         */
+        BufferedWriter(const std::string& fileName);
+
+        /**
+         * @brief Closes the file, writing what is left in the buffer. Errors are ignored, call `close` to get them
+         */
+        ~BufferedWriter();
+
+        BufferedWriter(const BufferedWriter& otherWriter) = delete;
+        BufferedWriter& operator=(const BufferedWriter& otherWriter) = delete;
+
+        /**
+         * @brief Writes what is left in the buffer and closes the file
+         *
+         * @throw std::invalid_argument - if the write fails
+         */
+        void close();
+
+        BufferedWriter& operator<<(std::string_view text);
+        BufferedWriter& operator<<(char character);
+        BufferedWriter& operator<<(uint value);
+
+        /**
+         * @brief Writes `value` with the fewest digits that read back to the same value(infinities are written as 1e30 or -1e30,
+         *        the infinity of the LP and MPS formats)
+         */
+        BufferedWriter& operator<<(double value);
+};
+
+#endif
@@ -5,18 +5,103 @@
 #include <sys/types.h>
 
 #include "bb_utils.h"
+#include "lp.h"
+#include "statistics.h"
+#include "model_generator.h"
+#include "perf_counters.h"
+#include "allocation_stats.h"
 
 #include <string>
 #include <tuple>
+#include <cstdint>
 
 typedef struct {
     std::vector<double> avg_execution_times;
     std::vector<std::pair<ExplorationStrategy, BranchingStrategy>> strats;
     std::vector<uint> explored_nodes;
+    std::vector<uint> lp_iterations;
 
-    std::vector<std::tuple<double, std::pair<ExplorationStrategy, BranchingStrategy>, uint>> things;
+    std::vector<std::tuple<double, std::pair<ExplorationStrategy, BranchingStrategy>, uint, uint>> things;
 }BenchmarkPerformanceMetrics;
 
+// version of the JSON and CSV benchmark suite reports
+#define BENCHMARK_REPORT_VERSION 1
+
+// a difference from the baseline is only significant if its p-value is below this level
+#define BENCHMARK_SIGNIFICANCE_LEVEL 0.05
+
+// how the runs(cells) of a benchmark are executed
+typedef struct {
+    uint jobs;          // cells run at the same time
+    bool isolate;       // run each cell in its own worker process instead of a thread, so cells don't share an allocator or a peak memory
+    bool pin;           // pin each worker to its own CPU
+    bool contention;    // run the cells serially too, and report how much slower they are when run in parallel
+}BenchmarkParallelism;
+
+// one run of a benchmark: a model solved with a pair of strategies. Cells are independent, and are grouped(e.g. by model) to be reported
+typedef struct {
+    LpProblem* problem;
+    ExplorationStrategy explorationStrat;
+    BranchingStrategy branchingStrat;
+    uint group;
+    bool measured;      // warmup cells aren't
+    bool perfCounters;  // collect the performance counters of the solve's phases
+    bool allocationStats;   // track the heap allocations of the solve's phases(only when the peak memory is measured too)
+}BenchmarkCell;
+
+// what a cell measured. It's plain data, so worker processes can send it back through a pipe as is
+typedef struct {
+    double time;            // ms
+    uint exploredNodes;
+    uint lpIterations;
+    uint64_t peakMemory;    // KB, 0 if it wasn't measured
+    ProblemStatus status;
+    double objective;       // objective function value of the optimal solution(0 if there is none)
+    PerfCounts phaseCounters[N_SOLVE_PHASES];
+    AllocationStats phaseAllocations[N_SOLVE_PHASES];
+}BenchmarkRun;
+
+// what a benchmark suite runs and where its reports go(empty file names skip a report)
+typedef struct {
+    std::string path;
+    uint warmupRuns;
+    uint measuredRuns;
+    ExplorationStrategy explorationStrat;
+    BranchingStrategy branchingStrat;
+    std::string jsonFile;
+    std::string csvFile;
+    std::string baselineFile;       // JSON report the results are compared with, if not empty
+    double regressionThreshold;     // % a median may grow by before a significant change is a regression
+    BenchmarkParallelism parallelism;
+    bool perfCounters;              // record the performance counters of each phase of the runs
+    bool allocationStats;           // record the heap allocations of each phase of the runs
+}BenchmarkSuiteOptions;
+
+// a benchmark over generated models of growing size, which stops after the first size whose median execution time exceeds `timeLimit`
+typedef struct {
+    GeneratorOptions model;         // the size is replaced by each of `sizes`
+    std::vector<uint> sizes;
+    double timeLimit;               // ms
+}BenchmarkSweep;
+
+// the measured runs of one model of a benchmark suite, one sample per run
+typedef struct {
+    std::string fileName;           // name of the model for generated models
+    std::string modelName;          // path of the model relative to its suite(its file name if it's outside), which matches it across checkouts
+    uint nRows;
+    uint nColumns;
+    ExplorationStrategy explorationStrat;
+    BranchingStrategy branchingStrat;
+    ProblemStatus status;
+    double objective;
+    std::vector<double> times;          // ms
+    std::vector<double> exploredNodes;
+    std::vector<double> lpIterations;
+    std::vector<double> peakMemory;     // KB
+    std::vector<std::pair<std::string, std::vector<double>>> phaseSamples;     // <phase>_<metric> samples of the performance counters(for the events
+                                                                                // which were counted) and heap allocations of each phase
+}BenchmarkModelResult;
+
 
 class Benchmark {
     private:
@@ -27,10 +112,160 @@ class Benchmark {
 
         void displayBenchmarkResults(uint metricsIndex);
 
+        /**
+         * @brief Solves the root LP relaxation of `benchmarkProblem`(the benchmark model) with and without scaling, and displays the model's
+         *        scaling quality and the number of simplex iterations of each run
+         */
+        void displayScalingResults(LpProblem& benchmarkProblem);
+
+        /**
+         * @brief Pins the calling thread(the whole process for a worker process) to the `slot`-th CPU the process may run on, wrapping around
+         *        if there are fewer CPUs than slots. Failures only print a warning, since pinning just reduces noise
+         */
+        static void pinToCpu(uint slot);
+
+        /**
+         * @brief Solves the model of `cell` and returns what was measured. The peak memory is only measured if `measureMemory` is true
+         */
+        static BenchmarkRun runCell(const BenchmarkCell& cell, bool measureMemory);
+
+        /**
+         * @brief Runs `cells` on `parallelism.jobs` threads(or worker processes if `parallelism.isolate` is true), and returns their runs in the
+         *        same order
+         *
+         * @throw std::invalid_argument - if a worker process fails
+         */
+        std::vector<BenchmarkRun> runCells(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism);
+
+        std::vector<BenchmarkRun> runCellsInThreads(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism);
+
+        /**
+         * @throw std::invalid_argument - if a worker process can't be started or fails
+         */
+        std::vector<BenchmarkRun> runCellsInProcesses(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism);
+
+        /**
+         * @brief Runs `cells` as `parallelism` says. In contention mode, they're run serially first and then in parallel, the slowdown of each group
+         *        (named by `groupNames`) is displayed, and the serial runs are returned
+         *
+         * @throw std::invalid_argument - if a worker process fails
+         */
+        std::vector<BenchmarkRun> executeCells(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism, const std::vector<std::string>& groupNames);
+
+        /**
+         * @brief Displays, for each group of cells, the median time of its serial and parallel runs and the slowdown between them, flagging groups
+         *        slowed down by more than 10 %
+         */
+        void displayContention(const std::vector<BenchmarkCell>& cells, const std::vector<BenchmarkRun>& serialRuns, const std::vector<BenchmarkRun>& parallelRuns,
+                               const std::vector<std::string>& groupNames);
+
+        /**
+         * @brief Returns the model files of a benchmark suite: the .lp and .mps files(possibly compressed) of the directory `path`, sorted by name,
+         *        or the files listed in the manifest `path`, one per line(blank lines and lines starting with # are skipped, and relative paths are
+         *        relative to the manifest's directory)
+         *
+         * @throw std::invalid_argument - if `path` doesn't exist or has no models
+         */
+        std::vector<std::string> getSuiteModels(const std::string& path);
+
+        /**
+         * @brief Returns the name `model`, a model of the suite `path`, is matched with in baselines: its path relative to the suite directory or
+         *        to the manifest's directory, or its file name if it's outside of it
+         */
+        std::string getSuiteModelName(const std::string& path, const std::string& model);
+
+        /**
+         * @brief Solves each of `problems`, named `names`, `options.warmupRuns` times without measuring them, then `options.measuredRuns` times,
+         *        recording the execution time, explored nodes, LP iterations and peak memory of each measured run(and the performance counters and
+         *        allocations of its phases if `options` asks for them, along with `parseCounts` and `parseAllocations`, those of reading each model).
+         *        The runs of every model are independent cells, executed as `options.parallelism` says
+         *
+         * @throw std::invalid_argument - if a worker process fails
+         */
+        std::vector<BenchmarkModelResult> benchmarkModels(std::vector<LpProblem>& problems, const std::vector<std::string>& names, const BenchmarkSuiteOptions& options,
+                                                          const std::vector<PerfCounts>& parseCounts = {}, const std::vector<AllocationStats>& parseAllocations = {});
+
+        void displaySuiteResults(const std::vector<BenchmarkModelResult>& results);
+
+        /**
+         * @brief Displays how the median execution time and explored nodes of a sweep's results grow with the model size: the local growth exponent
+         *        between consecutive sizes(k in time ~ size^k), and the time on a logarithmic scale
+         */
+        void displaySweepResults(const std::vector<BenchmarkModelResult>& results, const std::vector<uint>& sizes);
+
+        /**
+         * @brief Writes the JSON and CSV reports of `results` and compares them with `baseline` if `options` has a baseline report
+         *
+         * @return false if the comparison found a regression
+         * @throw std::invalid_argument - if a report can't be written
+         */
+        bool reportSuiteResults(const std::vector<BenchmarkModelResult>& results, const std::vector<BenchmarkModelResult>& baseline, const BenchmarkSuiteOptions& options);
+
+        /**
+         * @brief Writes the suite's options, and each model's samples and their statistics, to the JSON file `options.jsonFile`
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        void writeSuiteJson(const std::vector<BenchmarkModelResult>& results, const BenchmarkSuiteOptions& options);
+
+        /**
+         * @brief Writes one line per model and metric(model,metric,runs,min,median,p90,p99,mean,stddev) to the CSV file `options.csvFile`
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        void writeSuiteCsv(const std::vector<BenchmarkModelResult>& results, const BenchmarkSuiteOptions& options);
+
+        /**
+         * @brief Reads the model results(with their samples) of the JSON report `fileName`, written by writeSuiteJson
+         *
+         * @throw std::invalid_argument - if the file can't be read, isn't a benchmark report or was written by another report version
+         */
+        std::vector<BenchmarkModelResult> readSuiteJson(const std::string& fileName);
+
+        /**
+         * @brief Compares the execution times and explored nodes of `results` with those of the same model(by `modelName`, or by file name for
+         *        baseline reports which don't name their models) and strategies in
+         *        `baseline`, and displays each change, its Mann-Whitney p-value and whether it's a regression or an improvement(a significant change
+         *        bigger than `regressionThreshold`%). Runs which are only in `results` or only in `baseline` are listed too
+         *
+         * @return true if no metric regressed and every run was matched
+         */
+        bool compareSuiteResults(const std::vector<BenchmarkModelResult>& baseline, const std::vector<BenchmarkModelResult>& results, double regressionThreshold);
+
     public:
         Benchmark(uint numIterations = 10);
 
-        void runBenchmark();
+        /**
+         * @brief Solves the benchmark model(bench.lp) `iterations` times with every pair of strategies, executing the runs as `parallelism` says,
+         *        and displays the average execution time, explored nodes and LP iterations of each pair
+         */
+        void runBenchmark(const BenchmarkParallelism& parallelism);
+
+        /**
+         * @brief Reads the model file whose name is `fileName` `iterations` times, and displays the loading time and throughput(MB/s).
+         *        If `useCache` is true the model is read through its binary model cache, which the first read creates if needed.
+         *        The model is parsed by up to `threads` threads
+         */
+        void runLoadBenchmark(std::string fileName, bool useCache = false, uint threads = 1);
+
+        /**
+         * @brief Benchmarks every model of the suite `options.path`(see getSuiteModels) with the chosen strategies, displays the statistics of
+         *        each model's samples and writes the JSON and CSV reports. Models which can't be read are skipped with a warning. If there's a
+         *        baseline report, the results are then compared with it
+         *
+         * @return false if the comparison with the baseline found a regression
+         * @throw std::invalid_argument - if the suite has no models, or a report can't be written or read
+         */
+        bool runSuite(const BenchmarkSuiteOptions& options);
+
+        /**
+         * @brief Benchmarks a model generated for each size of `sweep`, in order, like `runSuite` does with the models of a suite(`options.path` isn't used),
+         *        and displays how the execution time and explored nodes grow with the size
+         *
+         * @return false if the comparison with the baseline found a regression
+         * @throw std::invalid_argument - if a model can't be generated, or a report can't be written or read
+         */
+        bool runSweep(const BenchmarkSweep& sweep, const BenchmarkSuiteOptions& options);
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,10 @@
 #include "bb_utils.h"
 #include "bb_tree.h"
 #include "bb_node.h"
+#include "cli/benchmark.h"
+
+// exit code of a benchmark suite whose comparison with its baseline found a regression(errors exit with EXIT_FAILURE)
+#define EXIT_REGRESSION 2
 
 enum FileExtension {
     LP,
@@ -16,12 +20,83 @@ typedef struct {
     ExplorationStrategy explorationStrat;
     BranchingStrategy branchingStrat;
     bool displayResults;
+    bool scaling;
+    LpAlgorithm rootAlgorithm;
+    bool crossover;
+    bool concurrentRoot;
+    bool portfolio;
+    bool modelCache;
+    uint parseThreads;
+    std::string dumpDirectory;
+    std::string dumpExtension;
+    bool resultCache;
+    bool perfCounters;
+    bool allocationStats;
+    std::string traceFile;          // Chrome trace event file the solve's timeline is written to, if not empty
+    std::string nodeLogFile;        // binary node log the search tree's nodes are written to, if not empty
+    double progressInterval;        // s between two progress lines, 0 to print none
+    std::string treeExportFile;     // DOT or JSON file --export-tree writes the node log `fileName` to
+    BenchmarkSuiteOptions suite;
+    BenchmarkSweep sweep;           // its model options are also those of --generate
 }Command;
 
 class CLI {
     private:
         std::vector<std::string> args;
         Command command;
+        int exitCode;
+
+        /**
+         * @brief Returns the model file named by `argument`: STDIN_FILE_NAME(the standard input), an existing file, or `argument` + ".lp"
+         *
+         * @throw std::invalid_argument - if none of them exists
+         */
+        std::string resolveModelFile(const std::string& argument);
+
+        /**
+         * @brief Converts the argument of --parse-threads to a number of threads, 0 meaning one per hardware thread
+         *
+         * @throw std::invalid_argument - if `argument` isn't a number
+         */
+        uint parseThreadCount(const std::string& argument);
+
+        /**
+         * @brief Converts `argument`, the value of the option `option`, to a count(e.g. of benchmark runs)
+         *
+         * @throw std::invalid_argument - if `argument` isn't a number
+         */
+        uint parseCount(const std::string& option, const std::string& argument);
+
+        /**
+         * @brief Converts `argument`, the value of the option `option`, to a non negative number
+         *
+         * @throw std::invalid_argument - if `argument` isn't a non negative number
+         */
+        double parseNonNegative(const std::string& option, const std::string& argument);
+
+        /**
+         * @brief Parses the benchmark suite option(--warmup, --runs, --strategy, --json, --csv, --compare, --threshold, --perf-counters or --alloc-stats) at `args[i]`, if it's one,
+         *        into `command.suite`, leaving `i` at its last argument
+         *
+         * @return false if `args[i]` isn't a benchmark suite option
+         */
+        bool parseSuiteOption(uint& i);
+
+        /**
+         * @brief Parses the benchmark parallelism option(--jobs, --isolate, --pin or --contention) at `args[i]`, if it's one, into
+         *        `command.suite.parallelism`, leaving `i` at its last argument
+         *
+         * @return false if `args[i]` isn't a parallelism option
+         */
+        bool parseParallelismOption(uint& i);
+
+        /**
+         * @brief Parses the model generator option(--rows, --density or --seed) at `args[i]`, if it's one, into `command.sweep.model`, leaving `i`
+         *        at its argument
+         *
+         * @return false if `args[i]` isn't a model generator option
+         */
+        bool parseGeneratorOption(uint& i);
 
         void validateCommand();
 
@@ -34,6 +109,11 @@ class CLI {
          * @brief Constructor, Takes in `argc`(number of arguments) and `argv`(arguments), and stores them in `args`, converting them to std::vector<std::string>
          */
         CLI(int argc, char** argv);
+
+        /**
+         * @brief Returns the process exit code of the command: EXIT_SUCCESS, EXIT_FAILURE if it failed, or EXIT_REGRESSION
+         */
+        int getExitCode() { return exitCode; }
 };
 
 #endif
\ No newline at end of file
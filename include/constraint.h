@@ -42,6 +42,11 @@ class Constraint {
 
         ///////////////////////////////////////
 
+        /**
+         * @brief Sets the RHS(right hand side) of the constraint
+         */
+        void setRhs(double newRhs) { rhs = newRhs; }
+
         /**
          * @brief Checks if the LHS coefficients, the constraint type and the RHS of two constraints are equal
          * 
@@ -53,6 +58,11 @@ class Constraint {
          * @brief Removes a variable(whose index is `varIndex`) that has been set to a specific value(`varValue`)
          */
         void removeFixedVariable(int varIndex, double varValue);
+
+        /**
+         * @brief If the RHS is negative, multiplies both sides of the constraint by -1(flipping its type), so that the RHS becomes positive
+         */
+        void normalizeRhs();
 };
 
 #endif
\ No newline at end of file
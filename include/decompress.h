@@ -0,0 +1,28 @@
+#ifndef DECOMPRESS_H
+#define DECOMPRESS_H
+
+#include <string>
+#include <string_view>
+
+// size of the blocks the output grows by while decompressing
+#define DECOMPRESS_BLOCK_SIZE (1 << 18)
+
+enum class Compression {
+    NONE,
+    GZIP,    // also zlib streams
+    ZSTD     // only supported when built with WITH_ZSTD(make ZSTD=1)
+};
+
+/**
+ * @brief Detects the compression of `data` from its first bytes(the magic number of the format)
+ */
+Compression detectCompression(std::string_view data);
+
+/**
+ * @brief Decompresses `data` one block at a time, directly into memory. Concatenated gzip members and zstd frames are decompressed one after another
+ *
+ * @throw std::invalid_argument - if `data` is corrupted or truncated, or `compression` is ZSTD and zstd support wasn't built in
+ */
+std::string decompress(std::string_view data, Compression compression);
+
+#endif
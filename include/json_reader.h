@@ -0,0 +1,83 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+
+enum class JsonType {
+    NULL_VALUE,
+    BOOLEAN,
+    NUMBER,
+    STRING,
+    ARRAY,
+    OBJECT
+};
+
+typedef struct JsonValue {
+    JsonType type;
+    bool boolean;
+    double number;
+    std::string text;
+    std::vector<struct JsonValue> items;                          // ARRAY elements
+    std::vector<std::pair<std::string, struct JsonValue>> members; // OBJECT members, in the order they were read
+}JsonValue;
+
+class JsonReader {
+    private:
+        std::string_view input;
+        size_t position;
+
+        JsonReader(std::string_view text);
+
+        /**
+         * @throw std::invalid_argument - always, with `message` and the current position
+         */
+        [[noreturn]] void error(const std::string& message);
+
+        void skipWhitespace();
+
+        /**
+         * @brief Consumes `character`, after any whitespace
+         *
+         * @throw std::invalid_argument - if the next character isn't `character`
+         */
+        void expect(char character);
+
+        /**
+         * @brief Reads a string(the opening quote included), decoding its escapes. \u escapes are decoded as UTF-8
+         *
+         * @throw std::invalid_argument - if the string isn't terminated or has an invalid escape
+         */
+        std::string readString();
+
+        /**
+         * @throw std::invalid_argument - if the input isn't a valid JSON value at the current position
+         */
+        JsonValue readValue();
+
+    public:
+        /**
+         * @brief Parses `text`, which must hold a single JSON value(and whitespace)
+         *
+         * @throw std::invalid_argument - if `text` isn't valid JSON
+         */
+        static JsonValue parse(std::string_view text);
+
+        /**
+         * @brief Parses the JSON file whose name is `fileName`
+         *
+         * @throw std::invalid_argument - if the file can't be read or isn't valid JSON
+         */
+        static JsonValue parseFile(const std::string& fileName);
+};
+
+/**
+ * @brief Returns the member of `object` named `name`
+ *
+ * @throw std::invalid_argument - if `object` isn't an object, has no such member or the member isn't of type `type`
+ */
+const JsonValue& getJsonMember(const JsonValue& object, const std::string& name, JsonType type);
+
+#endif
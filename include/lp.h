@@ -9,15 +9,22 @@
 #include <tuple>
 
 #include <limits>
+#include <atomic>
 #include <sys/types.h>
 
 #define M 1000000
+#define SIMPLEX_EPSILON 1e-9
 
 enum ProblemType {
     MIN,
     MAX
 };
 
+enum LpAlgorithm {
+    SIMPLEX,
+    BARRIER
+};
+
 enum ProblemStatus {
     NOT_YET_SOLVED,
     CONTINUOUS_SOLUTION,
@@ -26,17 +33,20 @@ enum ProblemStatus {
     UNBOUNDED
 };
 
-typedef struct {
-    std::vector<std::pair<uint, double>> fixedVariables;
-    std::vector<uint> constraintsToRemove;
-    std::vector<std::pair<uint, uint>> pairsOfVars;
-}SimplifiedConstraintsHelper;
-
 class LpProblem {
     private:
         ProblemType type;
         Matrix objectiveFunction;
+        double objectiveOffset;
         std::vector<Constraint> constraints;
+        std::vector<double> lowerBounds;
+        std::vector<double> upperBounds;
+        bool scalingEnabled;
+        LpAlgorithm algorithm;
+        bool crossoverEnabled;
+        uint lpIterations;
+        const std::atomic<bool>* cancelFlag;
+        std::pair<double, double> lastScalingQuality;
         Matrix optimalSolution;
         ProblemStatus status;
 
@@ -47,6 +57,11 @@ class LpProblem {
          */
         bool isSimplexDone(Matrix& cj_minus_zj);
 
+        /**
+         * @brief Checks if another thread asked the solve to stop, through the flag set with `setCancelFlag`
+         */
+        bool isCancelled() { return cancelFlag != NULL && cancelFlag->load(std::memory_order_relaxed); }
+
         /**
          * @brief Given the pivot column elements(), the b column elements, and the ratios column matrix, returns the index of the pivot row
          * 
@@ -115,61 +130,22 @@ class LpProblem {
         Matrix solveSimplex();
 
         /**
-         * @brief Checks if the LP problem can be simplified, and stores information about which constraints to remove 
-         *        and variables to fix in the `helper` variable passed as an argument
-         */
-        bool canProblemBeSimplified(SimplifiedConstraintsHelper* helper);
-
-        /**
-         * @brief Uses the information stored in the `helper` variable argument to simplify the problem
-         */
-        bool simplifyProblem(SimplifiedConstraintsHelper* helper);
-
-        /**
-         * @brief Uses the information stored in the `helper` variable argument and the simplified problem solution(`simplifiedSolution`)
-         *        to obtain the initial problem's solution
-         */
-        void simplifiedProblemSolution(SimplifiedConstraintsHelper* helper, Matrix& simplifiedSolution);
-
-        /**
-         * @brief Checks if any variables can be fixed and stores the constraints to remove and the set values of the those fixed variables
-         *        in the `helper` variable argument
-         */
-        void canVariablesBeFixed(SimplifiedConstraintsHelper* helper);
-
-        /**
-         * @brief Checks for repeated constraints and stores the indexes of those repeated constraints in the
-         *        `helper` variable argument
+         * @brief Solves the LP model using the barrier(interior point) method. If `crossover` is true, the simplex method is then
+         *        run on the optimal face found by barrier(the variables that aren't 0 at the interior solution), to obtain a basic solution.
+         *        Falls back to the simplex method if barrier doesn't converge
          */
-        void checkForRepeatedConstraints(SimplifiedConstraintsHelper* helper);
+        Matrix solveBarrier(bool crossover);
 
         /**
-         * @brief Checks the `helper` variable argumnt and removes redundant information
+         * @brief Checks if the variables have any bounds other than the default ones(x >= 0)
          */
-        void removeRepeatedFixedVariablesPairs(SimplifiedConstraintsHelper* helper);
+        bool hasVariableBounds();
 
         /**
-         * @brief For fixed variables, creates a correspondence between the original problem's variable's indexes 
-         *        and the simplified problem's variable's indexes, and stores it in the `helper` variable argument
+         * @brief Builds an equivalent LP model without variable bounds, to be solved by the simplex method: lower bounds are
+         *        shifted out of the model(x = lb + x') and finite upper bounds become constraints
          */
-        void newVarsToOldVars(SimplifiedConstraintsHelper* helper);
-
-        /**
-         * @brief Removes the constraints from the model whose indexes are stored in the `helper` variable argument
-         */
-        void removeConstraints(SimplifiedConstraintsHelper* helper);
-
-        /**
-         * @brief Sets the variable whose index is `varIndex` equal to `fixedVarValue`, and removes it from the objective function and all constraints
-         * 
-         * @throw std::invalid_argument - if `varIndex` < 0 or `varIndex` >= `objectiveFunction.getNColumns()`
-         */
-        void removeOneFixedVariable(int varIndex, double fixedVarValue);
-
-        /**
-         * @brief Removes all fixed variables, as specified by the `helper` argument
-         */
-        void removeFixedVariables(SimplifiedConstraintsHelper* helper);
+        LpProblem boundsAsConstraints();
 
     public:
         LpProblem(void) = default;
@@ -193,6 +169,12 @@ class LpProblem {
          */
         LpProblem& operator=(const LpProblem& otherProblem);
 
+        /**
+         * @brief Pivots the simplex tableau on (`pivotRow`, `pivotColumn`): the pivot row(and its b element) is divided by the pivot element, the
+         *        pivot column is eliminated from the other rows, and the zj row is recomputed from `cb`, which must already hold the new basis' costs
+         */
+        static void pivotTableau(Matrix& simplexTableau, Matrix& b, Matrix& cb, Matrix& zj, uint pivotRow, uint pivotColumn);
+
         /**
          * @brief Displays the current simplex tableau on the terminal
          */
@@ -229,6 +211,17 @@ class LpProblem {
          * @brief Returns `objectiveFunction`
          */
         Matrix& getObjectiveFunction() { return objectiveFunction; }
+
+        /**
+         * @brief Returns the constant term of the objective function(0 unless the model file has one)
+         */
+        double getObjectiveOffset() { return objectiveOffset; }
+
+        /**
+         * @brief Sets the constant term of the objective function. It's part of every objective function value shown, but doesn't change
+         *        the optimal solution
+         */
+        void setObjectiveOffset(double offset) { objectiveOffset = offset; }
         
         /**
          * @brief Returns the `status`
@@ -257,6 +250,68 @@ class LpProblem {
 
         std::vector<Constraint>& getConstraints() { return constraints; }
 
+        /**
+         * @brief Returns the lower bounds of the variables
+         */
+        std::vector<double>& getLowerBounds() { return lowerBounds; }
+
+        /**
+         * @brief Returns the upper bounds of the variables(INFINITY if a variable has no upper bound)
+         */
+        std::vector<double>& getUpperBounds() { return upperBounds; }
+
+        /**
+         * @brief Sets the bounds of the variable whose index is `varIndex`
+         * 
+         * @throw std::invalid_argument - if `varIndex` >= `objectiveFunction.getNColumns()`
+         */
+        void setVariableBounds(uint varIndex, double lower, double upper);
+
+        /**
+         * @brief Intersects the bounds of the variable whose index is `varIndex` with [`lower`, `upper`], and checks the constraints
+         *        the variable appears in. If the new bounds make the model infeasible, the status is set to INFEASIBLE, so that
+         *        the problem doesn't need to be solved
+         * 
+         * @throw std::invalid_argument - if `varIndex` >= `objectiveFunction.getNColumns()`
+         */
+        void tightenVariableBounds(uint varIndex, double lower, double upper);
+
+        /**
+         * @brief Enables or disables scaling of the constraints before the simplex method(enabled by default)
+         */
+        void setScaling(bool enabled) { scalingEnabled = enabled; }
+
+        /**
+         * @brief Sets the algorithm used to solve the LP model(SIMPLEX by default). `crossover` only applies to BARRIER
+         */
+        void setAlgorithm(LpAlgorithm newAlgorithm, bool crossover = true) { algorithm = newAlgorithm; crossoverEnabled = crossover; }
+
+        /**
+         * @brief Returns the algorithm used to solve the LP model
+         */
+        LpAlgorithm getAlgorithm() { return algorithm; }
+
+        /**
+         * @brief Sets a flag which, once true, makes the simplex and barrier methods stop at their next iteration, so that a solve running
+         *        on another thread can be cancelled. The result of a cancelled solve is meaningless. Pass NULL to remove the flag
+         */
+        void setCancelFlag(const std::atomic<bool>* flag) { cancelFlag = flag; }
+
+        /**
+         * @brief Returns the cancel flag(NULL if there is none)
+         */
+        const std::atomic<bool>* getCancelFlag() { return cancelFlag; }
+
+        /**
+         * @brief Returns the number of simplex(and barrier) iterations of the last solve
+         */
+        uint getLpIterations() { return lpIterations; }
+
+        /**
+         * @brief Returns the scaling quality(largest over smallest absolute coefficient) before and after scaling, for the last solve
+         */
+        std::pair<double, double> getScalingQuality() { return lastScalingQuality; }
+
 };
 
 /**
@@ -0,0 +1,97 @@
+#ifndef LP_FORMAT_READER_H
+#define LP_FORMAT_READER_H
+
+#include "sparse_model.h"
+#include "model_tokenizer.h"
+
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+enum class LpSection {
+    OBJECTIVE,
+    CONSTRAINTS,
+    BOUNDS,
+    GENERAL,
+    BINARY,
+    END
+};
+
+class LpFormatReader {
+    private:
+        ModelTokenizer tokenizer;
+        SparseModel model;
+
+        // symbol table: the keys point into the text being parsed
+        std::unordered_map<std::string_view, uint> columnIndexes;
+
+        // constraint matrix entries
+        TripletBuffer triplets;
+
+        /**
+         * @brief Returns the current token, skipping line breaks(the LP format isn't line oriented)
+         */
+        const Token& peek();
+
+        /**
+         * @brief Consumes and returns the current token, skipping line breaks
+         */
+        Token next();
+
+        /**
+         * @brief Throws std::invalid_argument with `message`, prefixed by the line number of `token`
+         */
+        [[noreturn]] void fail(const Token& token, const std::string& message);
+
+        /**
+         * @brief Checks if the current token starts a section keyword. If `consume` is true, the keyword is consumed and its section returned
+         *
+         * @return the section the keyword starts, or OBJECTIVE if the current token isn't a keyword
+         */
+        LpSection readSectionKeyword(bool consume);
+
+        /**
+         * @brief Returns the index of the variable named `name`, adding it to the model if it's new
+         */
+        uint getColumn(std::string_view name);
+
+        /**
+         * @brief Reads a signed number, which may be infinite(inf, infinity, or any value of at least 1e30)
+         */
+        double readValue();
+
+        /**
+         * @brief Checks if the current token can start a signed number(see `readValue`)
+         */
+        bool isValueStart();
+
+        /**
+         * @brief Reads a linear expression into `terms`, adding constant terms to `constant`. If `firstVariable` isn't empty, it was
+         *        already consumed and is the expression's first term(with coefficient 1)
+         */
+        void readExpression(std::vector<std::pair<uint, double>>& terms, double& constant, std::string_view firstVariable);
+
+        /**
+         * @brief Reads an optional `name:` label. Returns the name of a variable that was consumed while looking for the label, if there was no label
+         */
+        std::string_view readLabel(std::string& label);
+
+        void readObjective();
+        void readConstraint();
+        void readBound();
+
+        LpFormatReader(std::string_view text);
+
+    public:
+        /**
+         * @brief Parses a model in CPLEX LP format: an objective section(Maximize/Minimize), Subject To, and the optional Bounds,
+         *        General(or Integer) and Binary sections, followed by End. Variables are referred to by name, constraints may span several
+         *        lines and may be ranged(lower <= expression <= upper). The constraint matrix is built in compressed sparse column form
+         *
+         * @throw std::invalid_argument - if the model is invalid, or uses unsupported sections(semi-continuous variables, SOS, quadratic terms)
+         */
+        static SparseModel parse(std::string_view text);
+};
+
+#endif
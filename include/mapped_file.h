@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+
+class MappedFile {
+    private:
+        int fileDescriptor;
+        void* data;
+        size_t size;
+
+    public:
+        /**
+         * @brief Maps the file whose name is `fileName` into memory(read only), hinting the kernel that it will be read sequentially.
+         *        If the file can't be mapped(it doesn't exist, is empty, or isn't a regular file, like a pipe), `isMapped` returns false
+         */
+        MappedFile(const std::string& fileName);
+
+        /**
+         * @brief Unmaps the file
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile& otherFile) = delete;
+        MappedFile& operator=(const MappedFile& otherFile) = delete;
+
+        /**
+         * @brief Checks if the file was successfully mapped
+         */
+        bool isMapped() { return data != NULL; }
+
+        /**
+         * @brief Returns the contents of the file, which point directly into the mapped pages and are only valid while the file is mapped
+         */
+        std::string_view getContents() { return std::string_view((const char*)data, size); }
+};
+
+#endif
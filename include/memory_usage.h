@@ -0,0 +1,17 @@
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+
+/**
+ * @brief Resets the peak resident memory of the process to its current resident memory, so the next `getPeakMemory` only covers what
+ *        happens from now on. Returns false if the system doesn't support it(the peak then covers the whole life of the process)
+ */
+bool resetPeakMemory();
+
+/**
+ * @brief Returns the peak resident memory of the process, in KB(0 if it can't be read)
+ */
+size_t getPeakMemory();
+
+#endif
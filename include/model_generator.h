@@ -0,0 +1,90 @@
+#ifndef MODEL_GENERATOR_H
+#define MODEL_GENERATOR_H
+
+#include "sparse_model.h"
+
+#include <string>
+#include <random>
+#include <cstdint>
+#include <vector>
+#include <sys/types.h>
+
+enum class ModelFamily {
+    KNAPSACK,
+    SET_COVER,
+    ASSIGNMENT,
+    FACILITY_LOCATION,
+    RANDOM_IP
+};
+
+// parameters of a generated model. `size` is the family's main dimension(see ModelGenerator::generate), and `rows` and `density`
+// are only used by some families(0 picks the family's default)
+typedef struct {
+    ModelFamily family;
+    uint size;
+    uint rows;
+    double density;
+    uint64_t seed;
+}GeneratorOptions;
+
+class ModelGenerator {
+    private:
+        std::mt19937_64 random;
+
+        ModelGenerator(uint64_t seed);
+
+        /**
+         * @brief Returns a uniformly distributed integer in [`low`, `high`]. The engine's output is reduced by hand, unlike
+         *        std::uniform_int_distribution, so a seed generates the same model with every standard library
+         */
+        uint uniform(uint low, uint high);
+
+        /**
+         * @brief Returns true with probability `probability`
+         */
+        bool chance(double probability);
+
+        /**
+         * @brief Returns a model with `nColumns` non negative integer variables bounded by `upperBound` and the given objective type, with
+         *        no constraints yet
+         */
+        static SparseModel emptyModel(const std::string& name, ProblemType type, uint nColumns, double upperBound);
+
+        /**
+         * @brief Appends a row of type `rowType` to `model`, whose entries are added to `triplets`
+         */
+        static void addRow(SparseModel& model, TripletBuffer& triplets, const std::vector<std::pair<uint, double>>& entries, ConstraintType rowType, double rhs);
+
+        SparseModel generateKnapsack(uint nItems, uint nConstraints);
+        SparseModel generateSetCover(uint nSets, uint nElements, double density);
+        SparseModel generateAssignment(uint nAgents);
+        SparseModel generateFacilityLocation(uint nFacilities, uint nCustomers);
+        SparseModel generateRandomIp(uint nColumns, uint nRows, double density);
+
+    public:
+        /**
+         * @brief Generates a random model of the family `options.family`, which only depends on the options(including the seed):
+         *        - KNAPSACK: max profit of `size` binary items under `rows`(5) knapsack constraints, each with half the total weight as capacity
+         *        - SET_COVER: min cost choice of `size` binary sets covering `rows`(size / 2) elements, each set holding an element with probability `density`(0.2)
+         *        - ASSIGNMENT: min cost assignment of `size` agents to `size` tasks(size^2 binary variables)
+         *        - FACILITY_LOCATION: min opening and service cost of `size` uncapacitated facilities serving `rows`(2 * size) customers
+         *        - RANDOM_IP: max of `size` general integer variables under `rows`(size / 2) <= constraints of density `density`(0.3)
+         *
+         * @throw std::invalid_argument - if `options.size` is 0 or `options.density` is outside [0, 1]
+         */
+        static SparseModel generate(const GeneratorOptions& options);
+
+        /**
+         * @brief Returns the default options of `family`: size 10, default rows and density, seed 1
+         */
+        static GeneratorOptions defaultOptions(ModelFamily family);
+};
+
+std::string convertModelFamilyToString(ModelFamily family);
+
+/**
+ * @throw std::invalid_argument - if `name` isn't the name of a model family
+ */
+ModelFamily convertStringToModelFamily(const std::string& name);
+
+#endif
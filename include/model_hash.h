@@ -0,0 +1,23 @@
+#ifndef MODEL_HASH_H
+#define MODEL_HASH_H
+
+#include "lp.h"
+
+#include <cstdint>
+
+// two independent 64 bit hashes of a model: `key` names its result cache entry, and `check` is stored in the entry and compared on lookup,
+// so models whose keys collide never share a result
+typedef struct {
+    uint64_t key;
+    uint64_t check;
+}ModelFingerprint;
+
+/**
+ * @brief Returns the fingerprint of `problem`'s structure: its type, objective function, variable bounds and constraints. Coefficients are
+ *        hashed by their exact bit patterns(-0 and 0 being the same value), and the constraints are hashed in a canonical order, so only
+ *        models which differ by the order of their rows share a fingerprint. The order of the variables does matter, since the cached
+ *        solution is indexed by it
+ */
+ModelFingerprint canonicalModelFingerprint(LpProblem& problem);
+
+#endif
@@ -3,25 +3,102 @@
 
 #include <vector>
 #include <string>
-#include <tuple>
+#include <string_view>
 #include <utility>
 #include "lp.h"
+#include "model_tokenizer.h"
+#include "sparse_model.h"
 
+// file name which stands for the standard input
+#define STDIN_FILE_NAME "-"
+
+// minimum size of the pieces the constraint section is split into when it's read by several threads
+#define PARALLEL_PARSE_MIN_CHUNK (1 << 20)
+
+// the constraints read from one piece of the constraint section of an x1..xn model
+typedef struct {
+    TripletBuffer triplets;
+    std::vector<ConstraintType> rowTypes;
+    std::vector<double> rhs;
+    std::vector<std::string> warnings;
+}ConstraintChunk;
 
 class ModelFileReader {
     private:
 
         /**
-         * @brief Reads the problem's type and the objective function coefficients from the file whose name is fileName
+         * @brief Reads the whole file whose name is fileName(the standard input if it's STDIN_FILE_NAME) through a stream. Used when the file
+         *        can't be memory mapped(e.g. pipes)
+         *
+         * @throw std::invalid_argument - if the file can't be opened
+         */
+        static std::string readFile(std::string fileName);
+
+        /**
+         * @brief Reads a linear expression(e.g. 3x1 - x2 + 2.5x3) into `terms`, as (variable index, coefficient) pairs,
+         *        stopping at the first token which can't be part of it
+         *
+         * @throw std::invalid_argument - if a variable isn't named x<index>, with index >= 1
+         */
+        static void readTerms(ModelTokenizer& tokenizer, std::vector<std::pair<uint, double>>& terms);
+
+        /**
+         * @brief Reads the constraints(one per line) of `text`, a piece of the constraint section of an x1..xn model whose first line is
+         *        `firstLine`, into `chunk`. Invalid constraints are skipped, with a warning added to the chunk
+         *
+         * @throw std::invalid_argument - if a constraint uses a variable whose index is >= `nVariables`
+         */
+        static void readConstraints(std::string_view text, uint firstLine, uint nVariables, ConstraintChunk& chunk);
+
+        /**
+         * @brief Parses a model in the x1..xn format(max: 3x1 + 2x2, followed by a blank line and one constraint per line) in a single pass over `text`.
+         *        Every variable is integer and non negative. Constraint sections bigger than PARALLEL_PARSE_MIN_CHUNK are split into pieces, which
+         *        are read by up to `threads` threads and merged afterwards
+         *
+         * @throw std::invalid_argument - if the objective function is missing or invalid, or a constraint uses a variable that isn't in the objective function
+         */
+        static SparseModel parseModel(std::string_view text, uint threads = 1);
+
+        /**
+         * @brief Parses a model in MPS format(see MpsReader), trying free MPS first and then fixed MPS. The COLUMNS section is read by up to `threads` threads
+         *
+         * @throw std::invalid_argument - if the model is invalid
+         */
+        static SparseModel parseMps(std::string_view text, uint threads = 1);
+
+        /**
+         * @brief Checks if `text` is a model in the x1..xn format, which starts with max: or min:(as opposed to the CPLEX LP format)
+         */
+        static bool isLegacyFormat(std::string_view text);
+
+        /**
+         * @brief Checks if the model in `text`, read from the file whose name is `fileName`, is an MPS model: files are MPS models if their extension
+         *        is .mps(before a .gz or .zst extension), and the standard input if its first section keyword is an MPS one(NAME, ROWS, ...)
+         */
+        static bool isMpsModel(const std::string& fileName, std::string_view text);
+
+        /**
+         * @brief Builds the LP model of `model`, warning about continuous variables(every variable is solved as an integer variable)
+         */
+        static LpProblem buildProblem(const SparseModel& model);
+
+        /**
+         * @brief Parses `text` as an MPS model if `mps` is true, and as an x1..xn or CPLEX LP model otherwise. x1..xn and MPS models are read by up to `threads` threads
          */
-        static std::pair<std::string, std::vector<double>> readObjectiveFunction(std::string fileName);
+        static SparseModel parseText(std::string_view text, bool mps, uint threads);
 
         /**
-         * @brief Reads the problem's constraints from the file whose name is fileName
+         * @brief Parses the model file whose name is fileName(the standard input if it's STDIN_FILE_NAME), memory mapping it when possible.
+         *        Files compressed with gzip or zstd are decompressed in memory first
          */
-        static std::vector<std::tuple<std::vector<double>, std::string, double>> readConstraints(std::string fileName, unsigned varsNumber);
+        static SparseModel parseFile(std::string fileName, uint threads);
     public:
 
+        /**
+         * @brief Splits `text` into at most `nPieces` pieces of similar size, which end at line breaks
+         */
+        static std::vector<std::string_view> splitLines(std::string_view text, uint nPieces);
+
         /**
          * @brief Constructor for the ModelFileReader class
          * 
@@ -29,12 +106,22 @@ class ModelFileReader {
         ModelFileReader();
         
         /**
-         * @brief Given the path of the model file, reads a linear programming problem and returns an LpProblem object with the model
+         * @brief Given the path of the model file, reads a linear programming problem and returns an LpProblem object with the model.
+         *        Files whose extension is .mps are read as MPS models, other files in the x1..xn format or in the CPLEX LP format. Files compressed
+         *        with gzip or zstd(e.g. model.mps.gz) are decompressed while they're read, and STDIN_FILE_NAME reads the model from the standard input
          * 
          * @param fileName the path to the model file
+         * @param useCache if true, the parsed model is cached in a binary model file next to the source(fileName + BINARY_MODEL_EXTENSION),
+         *                 which is mapped and read instead of parsing the source as long as the source doesn't change
+         * @param threads maximum number of threads used to parse the model(the constraints of x1..xn models and the COLUMNS section of MPS models are parsed in parallel)
          * @return LpProblem - the model read, encapsulated in the LpProblem class
          */
-        static LpProblem readModel(std::string fileName);
+        static LpProblem readModel(std::string fileName, bool useCache = false, uint threads = 1);
+
+        /**
+         * @brief Same as `readModel`, but returns the sparse model, before it's turned into the dense LP model used by the solver
+         */
+        static SparseModel readSparseModel(std::string fileName, bool useCache = false, uint threads = 1);
 };
 
-#endif
\ No newline at end of file
+#endif
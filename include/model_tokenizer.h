@@ -0,0 +1,69 @@
+#ifndef MODEL_TOKENIZER_H
+#define MODEL_TOKENIZER_H
+
+#include <string_view>
+#include <sys/types.h>
+
+enum class TokenType {
+    NUMBER,
+    IDENTIFIER,
+    PLUS,
+    MINUS,
+    LESS_EQUAL,      // <= or <
+    GREATER_EQUAL,   // >= or >
+    EQUAL,           // =
+    COLON,
+    NEWLINE,
+    END_OF_INPUT
+};
+
+typedef struct {
+    TokenType type;
+    std::string_view text;   // points into the tokenizer's input, so it's only valid while the input is
+    double value;            // only set for NUMBER tokens
+    uint line;
+}Token;
+
+class ModelTokenizer {
+    private:
+        std::string_view input;
+        size_t position;
+        uint line;
+        Token current;
+
+        /**
+         * @brief Scans the token starting at `position`
+         *
+         * @throw std::invalid_argument - if the input contains a character that can't start a token
+         */
+        Token scan();
+
+    public:
+        /**
+         * @brief Constructs a tokenizer over `text`, which isn't copied and must outlive the tokenizer. Line numbers start at `firstLine`,
+         *        which allows a piece of a bigger text to be tokenized on its own
+         */
+        ModelTokenizer(std::string_view text, uint firstLine = 1);
+
+        /**
+         * @brief Returns the current token, without consuming it
+         */
+        const Token& peek() { return current; }
+
+        /**
+         * @brief Consumes and returns the current token
+         */
+        Token next();
+
+        /**
+         * @brief Returns the offset of the current token in the input(the input's size at the end of the input)
+         */
+        size_t getOffset() { return (current.type == TokenType::END_OF_INPUT) ? input.size() : current.text.data() - input.data(); }
+
+        /**
+         * @brief Consumes every token up to(and including) the next NEWLINE
+         */
+        void skipLine();
+};
+
+#endif
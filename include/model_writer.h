@@ -0,0 +1,44 @@
+#ifndef MODEL_WRITER_H
+#define MODEL_WRITER_H
+
+#include <string>
+#include "lp.h"
+#include "buffered_writer.h"
+
+// number of terms written on each line of an LP format expression
+#define LP_FORMAT_TERMS_PER_LINE 8
+
+class ModelFileWriter {
+    private:
+        /**
+         * @brief Writes `coefficient` * x<`column` + 1> as a term of an LP format expression. preceded by its sign(which is only written for the first term if it's negative)
+         */
+        static void writeLpTerm(BufferedWriter& writer, double coefficient, uint column, bool first);
+
+        /**
+         * @brief Writes `problem` in the CPLEX LP format. Variables are named x1..xn and constraints R1..Rm, and every variable is written as integer
+         */
+        static void writeLp(LpProblem& problem, BufferedWriter& writer);
+
+        /**
+         * @brief Writes `problem` in free MPS format, with the same names as `writeLp` and every variable between integer markers
+         */
+        static void writeMps(LpProblem& problem, BufferedWriter& writer);
+
+    public:
+        /**
+         * @brief Constructor for the ModelFileWriter class
+         */
+        ModelFileWriter();
+
+        /**
+         * @brief Writes `problem`, including the bounds of its variables(e.g. the branching bounds of a node's LP model), to the file whose
+         *        name is `fileName`. Files whose extension is .mps are written in MPS format, other files in the CPLEX LP format, so that
+         *        ModelFileReader reads them back. The output goes through a BufferedWriter
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        static void writeModel(LpProblem& problem, std::string fileName);
+};
+
+#endif
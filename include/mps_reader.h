@@ -0,0 +1,114 @@
+#ifndef MPS_READER_H
+#define MPS_READER_H
+
+#include "sparse_model.h"
+
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+enum class MpsFormat {
+    FREE,    // fields separated by whitespace
+    FIXED    // fields in fixed columns(2-3, 5-12, 15-22, 25-36, 40-47 and 50-61), which allows spaces in names
+};
+
+enum class MpsSection {
+    NONE,
+    NAME,
+    OBJSENSE,
+    ROWS,
+    COLUMNS,
+    RHS,
+    RANGES,
+    BOUNDS,
+    ENDATA
+};
+
+class MpsReader {
+    private:
+        SparseModel model;
+        MpsFormat format;
+        MpsSection section;
+        uint line;
+
+        // the keys point into the text being parsed
+        std::unordered_map<std::string_view, int> rowIndexes;       // -1 for the objective row and other free(N) rows
+        std::unordered_map<std::string_view, uint> columnIndexes;
+        std::string_view objectiveRow;
+        bool integerMarker;
+
+        // readers of the pieces of a COLUMNS section read on several threads look rows up in the reader of the whole model, and don't know
+        // which MARKER line comes before their piece: the columns before their first MARKER line take the integer state of the previous piece
+        const MpsReader* rowSource;
+        bool sawMarker;
+        uint firstMarkedColumn;
+
+        /**
+         * @brief Splits a data line into its fields
+         */
+        std::vector<std::string_view> splitFields(std::string_view text);
+
+        /**
+         * @brief Converts `field` to a number
+         *
+         * @throw std::invalid_argument - if `field` isn't a number
+         */
+        double parseNumber(std::string_view field);
+
+        /**
+         * @brief Returns the index of the row named `name`(-1 for free rows)
+         *
+         * @throw std::invalid_argument - if there's no row named `name`
+         */
+        int findRow(std::string_view name);
+
+        /**
+         * @brief Returns the index of the column named `name`
+         *
+         * @throw std::invalid_argument - if there's no column named `name`
+         */
+        uint findColumn(std::string_view name);
+
+        /**
+         * @brief Handles a section header line, which may carry data too(NAME and, in free MPS, OBJSENSE)
+         */
+        void readHeader(std::string_view text);
+
+        void readRow(const std::vector<std::string_view>& fields);
+        void readColumn(const std::vector<std::string_view>& fields);
+        void readRhsOrRange(const std::vector<std::string_view>& fields);
+        void readBound(const std::vector<std::string_view>& fields);
+
+        /**
+         * @brief Reads `piece`, a piece of the COLUMNS section which only has data lines, comments and blank lines, into the columns of this reader
+         */
+        void readColumnPiece(std::string_view piece);
+
+        /**
+         * @brief Reads `columns`, the data lines of a COLUMNS section, which starts after the current line. Sections bigger than PARALLEL_PARSE_MIN_CHUNK
+         *        are split at line breaks into pieces read by up to `threads` threads, which are appended in order to the columns of the model
+         *        afterwards. A column whose entries span two pieces is joined back together
+         *
+         * @throw std::invalid_argument - if a column is invalid, or the entries of a column aren't contiguous. The first error in the section is reported
+         */
+        void readColumnSection(std::string_view columns, uint threads);
+
+        /**
+         * @brief Throws std::invalid_argument with `message`, prefixed by the current line number
+         */
+        [[noreturn]] void fail(const std::string& message);
+
+        MpsReader(MpsFormat mpsFormat, const MpsReader* rows = nullptr);
+
+    public:
+        /**
+         * @brief Parses an MPS model in a single pass over `text`, building its constraint matrix directly in compressed sparse column form.
+         *        Supports the NAME, OBJSENSE, ROWS, COLUMNS(including integer MARKER lines), RHS, RANGES and BOUNDS sections. Big COLUMNS
+         *        sections are read by up to `threads` threads(see readColumnSection)
+         *
+         * @throw std::invalid_argument - if the model is invalid
+         */
+        static SparseModel parse(std::string_view text, MpsFormat format = MpsFormat::FREE, uint threads = 1);
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef NODE_LOG_H
+#define NODE_LOG_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#define NODE_LOG_MAGIC "BBNODES"
+#define NODE_LOG_VERSION 1
+
+// parent of the root node
+#define NODE_LOG_NO_PARENT UINT32_MAX
+
+// what happened to a node of the search tree
+enum NodeFate {
+    NODE_UNSOLVED,      // created, but the search ended before its LP relaxation was solved
+    NODE_OPEN,          // solved, but the search ended before it was branched on or pruned
+    NODE_BRANCHED,
+    NODE_INTEGRAL,      // its LP solution was integral(a candidate incumbent)
+    NODE_INFEASIBLE,
+    NODE_UNBOUNDED,
+    NODE_PRUNED,        // its bound was no better than the incumbent's
+};
+
+// which bound of its parent's branching variable a node tightened
+enum NodeDirection {
+    NODE_ROOT,
+    NODE_LEFT,          // x <= floor(value)
+    NODE_RIGHT,         // x >= ceil(value)
+};
+
+// one node of the search tree, as stored in a node log(fixed size, no padding)
+typedef struct {
+    uint32_t id;                // order in which the node was created, the root being 0
+    uint32_t parent;            // NODE_LOG_NO_PARENT for the root
+    uint32_t depth;
+    uint32_t lpIterations;
+    uint32_t fractionalCount;   // variables with a fractional value in the node's LP solution
+    int32_t branchVariable;     // index(in the presolved model) of the variable the node was branched on, -1 if it wasn't
+    double branchValue;         // value of the branching variable in the node's LP solution
+    double bound;               // objective function value of the node's LP solution, NAN if there is none
+    double solveTime;           // ms
+    uint8_t fate;               // NodeFate
+    uint8_t direction;          // NodeDirection
+    uint8_t padding[6];
+}NodeRecord;
+
+// fixed size header at the start of every node log file, followed by `nRecords` NodeRecord
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t nRecords;
+}NodeLogHeader;
+
+std::string convertNodeFateToString(NodeFate fate);
+
+class NodeLog {
+    public:
+        /**
+         * @brief Returns a record of a new node, whose LP relaxation isn't solved yet
+         */
+        static NodeRecord newRecord(uint32_t id, uint32_t parent, uint32_t depth, NodeDirection direction);
+
+        /**
+         * @brief Writes `records` to the binary node log file whose name is `fileName`
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        static void write(const std::vector<NodeRecord>& records, const std::string& fileName);
+
+        /**
+         * @brief Reads the records of the binary node log file whose name is `fileName`
+         *
+         * @throw std::invalid_argument - if the file can't be read, isn't a node log, was written by another version, has fewer records than its
+         *        header says or has a record whose fate or direction isn't a NodeFate or NodeDirection
+         */
+        static std::vector<NodeRecord> read(const std::string& fileName);
+
+        /**
+         * @brief Writes the search tree of `records` to the Graphviz file `fileName`: one box per node, colored by its fate, and one edge per
+         *        branch, labeled with the bound it tightened
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        static void writeDot(const std::vector<NodeRecord>& records, const std::string& fileName);
+
+        /**
+         * @brief Writes `records` to the JSON file `fileName`, as an array of node objects
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        static void writeJson(const std::vector<NodeRecord>& records, const std::string& fileName);
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <string>
+#include <cstdint>
+
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_PAGE_FAULTS,
+    N_PERF_EVENTS,
+};
+
+// what the counters counted during one phase. Events which couldn't be counted(or phases which weren't measured) aren't available
+typedef struct {
+    uint64_t counts[N_PERF_EVENTS];
+    bool available[N_PERF_EVENTS];
+}PerfCounts;
+
+// layout of a counter read with PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+typedef struct {
+    uint64_t value;
+    uint64_t timeEnabled;
+    uint64_t timeRunning;
+}CounterReading;
+
+/**
+ * @brief Returns counts with no event available
+ */
+PerfCounts emptyPerfCounts();
+
+/**
+ * @brief Checks if at least one event of `counts` is available
+ */
+bool hasPerfCounts(const PerfCounts& counts);
+
+/**
+ * @brief Adds the available events of `counts` to `total`, making them available there
+ */
+void addPerfCounts(PerfCounts& total, const PerfCounts& counts);
+
+std::string convertPerfEventToString(PerfEvent event);
+
+// hardware(cycles, instructions, cache and branch misses) and software(page faults) performance counters of the calling thread, read
+// through perf_event_open. Threads the calling thread creates after the counters are opened are counted too, once they end.
+// Each event is opened on its own, so the events the system supports are still counted when others aren't(e.g. in virtual machines
+// without a PMU, or when perf_event_paranoid forbids them)
+class PerfCounters {
+    private:
+        int descriptors[N_PERF_EVENTS];
+        CounterReading startReadings[N_PERF_EVENTS];
+        std::string error;
+
+    public:
+        /**
+         * @brief Opens the counters, disabled. Events which can't be opened are left out, recording why in `getError`
+         */
+        PerfCounters();
+
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /**
+         * @brief Checks if at least one event could be opened
+         */
+        bool isAvailable();
+
+        /**
+         * @brief Returns why the first event which couldn't be opened wasn't(empty if every event was opened)
+         */
+        std::string getError() { return error; }
+
+        /**
+         * @brief Enables the counters, counting from now on
+         */
+        void start();
+
+        /**
+         * @brief Disables the counters and returns what they counted since `start`. Counts of events which the kernel multiplexed with
+         *        others are scaled to the whole time they were enabled
+         */
+        PerfCounts stop();
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include "bb_tree.h"
+#include "bb_utils.h"
+#include "shared_incumbent.h"
+
+#include <vector>
+#include <utility>
+#include <memory>
+
+class Portfolio {
+    private:
+        LpProblem problem;
+        std::vector<std::pair<ExplorationStrategy, BranchingStrategy>> strategies;
+        std::vector<BaBTree> trees;
+        std::shared_ptr<SharedIncumbent> incumbent;
+        bool scaling;
+        LpAlgorithm rootAlgorithm;
+        bool crossover;
+        bool concurrentRoot;
+        int winner;
+
+    public:
+        /**
+         * @brief Constructs a portfolio which solves `initialProblem` with each pair of strategies in `portfolioStrategies`, concurrently
+         *
+         * @throw std::invalid_argument - if `portfolioStrategies` is empty
+         */
+        Portfolio(LpProblem initialProblem, std::vector<std::pair<ExplorationStrategy, BranchingStrategy>> portfolioStrategies);
+
+        /**
+         * @brief Builds a portfolio of at most `size` strategy pairs, starting with `first` and followed by every other pair which prunes
+         *        nodes(EXPLORE_ALL_NODES is left out)
+         */
+        static std::vector<std::pair<ExplorationStrategy, BranchingStrategy>> defaultStrategies(std::pair<ExplorationStrategy, BranchingStrategy> first, uint size);
+
+        /**
+         * @brief Enables or disables scaling of the nodes' LP problems(enabled by default)
+         */
+        void setScaling(bool enabled) { scaling = enabled; }
+
+        /**
+         * @brief Sets the algorithm every tree solves its root node's LP relaxation with(see BaBTree::setRootAlgorithm)
+         */
+        void setRootAlgorithm(LpAlgorithm algorithm, bool useCrossover = true) { rootAlgorithm = algorithm; crossover = useCrossover; }
+
+        /**
+         * @brief Enables or disables racing the LP algorithms on the root node's LP relaxation of every tree(see BaBTree::setConcurrentRoot)
+         */
+        void setConcurrentRoot(bool enabled) { concurrentRoot = enabled; }
+
+        /**
+         * @brief Solves one tree per strategy pair, each on its own thread. The trees share their incumbent solution, and all of them
+         *        stop as soon as one finishes its search, which proves the shared incumbent is optimal
+         */
+        Matrix solve();
+
+        /**
+         * @brief Displays the strategies of the tree that finished first, and its solution and performance metrics
+         */
+        void displayProblem(Matrix optimalWholeSolution);
+
+        /**
+         * @brief Returns the strategies of the tree that finished first
+         */
+        std::pair<ExplorationStrategy, BranchingStrategy> getWinnerStrategies() { return strategies[winner]; }
+
+        /**
+         * @brief Returns the performance metrics of the tree that finished first
+         */
+        PerformanceMetrics getMetrics() { return trees[winner].getMetrics(); }
+
+        /**
+         * @brief Deletes the nodes of every tree
+         */
+        void deleteTrees();
+};
+
+#endif
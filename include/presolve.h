@@ -0,0 +1,237 @@
+#ifndef PRESOLVE_H
+#define PRESOLVE_H
+
+#include "lp.h"
+
+#include <vector>
+#include <utility>
+#include <sys/types.h>
+
+#define MAX_PRESOLVE_ROUNDS 20
+
+enum PostsolveStepType {
+    FIXED_COLUMN,          // x[column] = value
+    MERGED_COLUMNS,        // x[column] + x[otherColumn] were replaced by x[column]
+    SUBSTITUTED_COLUMN     // x[column] = (value - sum(rowEntries)) / bound
+};
+
+typedef struct {
+    PostsolveStepType type;
+    uint column;
+    uint otherColumn;
+    double value;
+    double bound;
+    std::vector<std::pair<uint, double>> rowEntries;
+}PostsolveStep;
+
+typedef struct {
+    uint removedRows;
+    uint removedColumns;
+    uint duplicateRows;
+    uint duplicateColumns;
+    uint singletonRows;
+    uint substitutedColumns;
+    uint dominatedColumns;
+    uint tightenedBounds;
+    uint tightenedCoefficients;
+}PresolveStats;
+
+class PostsolveStack {
+    private:
+        uint nOriginalColumns;
+        std::vector<uint> reducedToOriginal;
+        std::vector<double> columnOffsets;
+        std::vector<PostsolveStep> steps;
+        double objectiveOffset;
+
+    public:
+        PostsolveStack(void);
+
+        /**
+         * @brief Constructs an empty postsolve stack for a model with `originalColumns` variables
+         */
+        PostsolveStack(uint originalColumns);
+
+        /**
+         * @brief Pushes a reduction onto the stack. Reductions are undone in reverse order by `postsolve`
+         */
+        void push(const PostsolveStep& step);
+
+        /**
+         * @brief Sets the correspondence between the reduced problem's variables and the original ones, along with
+         *        the lower bound each reduced variable was shifted by
+         */
+        void setColumnMap(const std::vector<uint>& map, const std::vector<double>& offsets);
+
+        /**
+         * @brief Adds `offset` to the constant term the reduced objective function is missing
+         */
+        void addObjectiveOffset(double offset) { objectiveOffset += offset; }
+
+        /**
+         * @brief Returns the constant term that has to be added to the reduced objective function value to obtain the original one
+         */
+        double getObjectiveOffset() const { return objectiveOffset; }
+
+        /**
+         * @brief Returns the number of variables of the original model
+         */
+        uint getNOriginalColumns() const { return nOriginalColumns; }
+
+        /**
+         * @brief Returns the number of variables of the reduced model
+         */
+        uint getNReducedColumns() const { return reducedToOriginal.size(); }
+
+        /**
+         * @brief Returns the original index of each reduced variable
+         */
+        const std::vector<uint>& getColumnMap() const { return reducedToOriginal; }
+
+        /**
+         * @brief Returns the value each reduced variable was shifted by(x = x' + offset)
+         */
+        const std::vector<double>& getColumnOffsets() const { return columnOffsets; }
+
+        /**
+         * @brief Maps a solution of the reduced model back to the original model's variables
+         *
+         * @throw std::invalid_argument - if `reducedSolution.size()` != `getNReducedColumns()`
+         */
+        std::vector<double> postsolve(const std::vector<double>& reducedSolution) const;
+};
+
+class Presolver {
+    private:
+        ProblemType type;
+        double objectiveSign;
+        uint nRows, nColumns;
+
+        // rows are kept sparse, with their entries sorted by column index
+        std::vector<std::vector<std::pair<uint, double>>> rows;
+        std::vector<double> rowLower, rowUpper;
+        std::vector<bool> rowActive;
+
+        // for each column, the rows it appears in(may contain rows that were meanwhile removed)
+        std::vector<std::vector<uint>> columns;
+        std::vector<double> cost;
+        std::vector<double> colLower, colUpper;
+        std::vector<double> impliedLower, impliedUpper;
+        std::vector<bool> colActive, colInteger;
+
+        PostsolveStack postsolveStack;
+        PresolveStats stats;
+        bool infeasible;
+
+        /**
+         * @brief Converts the dense constraints of `problem` into the sparse row/column representation used by the presolver
+         */
+        void buildFromProblem(LpProblem& problem, bool integerVariables);
+
+        /**
+         * @brief Returns the coefficient of `column` in `row`, or 0 if the column doesn't appear in the row
+         */
+        double getCoefficient(uint row, uint column);
+
+        /**
+         * @brief Removes the entry of `column` from `row`, if there is one
+         */
+        void eraseEntry(uint row, uint column);
+
+        /**
+         * @brief Drops the references to removed rows from `column`'s row list and returns how many rows remain
+         */
+        uint compactColumn(uint column);
+
+        /**
+         * @brief Marks `row` as removed
+         */
+        void removeRow(uint row);
+
+        /**
+         * @brief Sets `column` to `value`, removes it from every row and records the reduction in the postsolve stack
+         */
+        void fixColumn(uint column, double value);
+
+        /**
+         * @brief Tightens the bounds of `column` to [`lower`, `upper`], rounding them first if the column is integer.
+         *        If `modelBound` is true the bounds become part of the model, otherwise they are only implied by it
+         *
+         * @return true if any bound was tightened
+         */
+        bool tightenColumnBounds(uint column, double lower, double upper, bool modelBound);
+
+        /**
+         * @brief Removes empty rows and turns rows with a single entry into bounds of their variable
+         */
+        bool removeEmptyAndSingletonRows();
+
+        /**
+         * @brief Finds rows which are multiples of each other using a hash of their normalized coefficients, and merges them
+         */
+        bool removeDuplicateRows();
+
+        /**
+         * @brief Uses the activity bounds of each row to tighten the variables' bounds, and removes redundant and forcing rows
+         */
+        bool tightenBounds();
+
+        /**
+         * @brief Fixes variables whose bounds are equal, empty columns, and columns whose optimal value is always one of its bounds
+         */
+        bool removeFixedAndDominatedColumns();
+
+        /**
+         * @brief Reduces the coefficients of binary variables in inequality rows, as long as the integer solutions remain the same
+         */
+        bool tightenCoefficients();
+
+        /**
+         * @brief Substitutes variables that only appear in a single equality row out of the model
+         */
+        bool substituteSingletonColumns();
+
+        /**
+         * @brief Finds identical columns using a hash of their coefficients, and merges them into a single variable
+         */
+        bool removeDuplicateColumns();
+
+        /**
+         * @brief Builds the column map of the postsolve stack, once all the reductions are done
+         */
+        void finalizeColumns();
+
+    public:
+        /**
+         * @brief Builds a presolver for `problem`. If `integerVariables` is true, all variables are considered integer,
+         *        which allows bounds to be rounded and coefficients to be tightened
+         */
+        Presolver(LpProblem& problem, bool integerVariables = true);
+
+        /**
+         * @brief Applies all reductions until none of them changes the model anymore(or MAX_PRESOLVE_ROUNDS is reached)
+         *
+         * @return INFEASIBLE or UNBOUNDED if presolve decided the problem, NOT_YET_SOLVED otherwise
+         */
+        ProblemStatus presolve();
+
+        /**
+         * @brief Builds the reduced LP model, whose objective function constant term is the postsolve stack's. Must be called after
+         *        `presolve`, and only if the reduced model has at least one variable
+         *
+         * @throw std::invalid_argument - if the reduced model has no variables
+         */
+        LpProblem getReducedProblem();
+
+        /**
+         * @brief Returns the postsolve stack, used to map solutions of the reduced model back to the original model
+         */
+        const PostsolveStack& getPostsolveStack() { return postsolveStack; }
+
+        /**
+         * @brief Returns the number of reductions of each kind that were applied
+         */
+        PresolveStats getStats() { return stats; }
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <sys/types.h>
+
+// state of a search at some point. The incumbent and the bound are objective function values of the original model, NAN if there are none
+typedef struct {
+    double time;            // s since the reporter started
+    uint exploredNodes;
+    uint openNodes;
+    uint64_t lpIterations;
+    double incumbent;
+    double bound;           // best LP bound of the open nodes
+}ProgressSnapshot;
+
+// prints a status line(elapsed time, explored and open nodes, nodes per second, incumbent, best bound, gap and LP iterations per node)
+// to the standard error every `interval` seconds, from its own thread. The search only builds a snapshot when the reporter asks for one,
+// which costs it a relaxed atomic load per iteration otherwise, and publishes it through a sequence lock, so neither side ever waits
+// for the other. Snapshots must be published by a single thread
+class ProgressReporter {
+    private:
+        double interval;
+        std::chrono::steady_clock::time_point startTime;
+        std::atomic<bool> requested;
+
+        // the published snapshot, guarded by `sequence`(odd while it's being written)
+        std::atomic<uint64_t> sequence;
+        std::atomic<double> time;
+        std::atomic<uint> exploredNodes;
+        std::atomic<uint> openNodes;
+        std::atomic<uint64_t> lpIterations;
+        std::atomic<double> incumbent;
+        std::atomic<double> bound;
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        bool stopping;
+
+        /**
+         * @brief Reads the published snapshot into `snapshot`, retrying while it's being written
+         *
+         * @return false if no snapshot was published yet
+         */
+        bool readSnapshot(ProgressSnapshot& snapshot);
+
+        /**
+         * @brief Prints the status line of `snapshot`, `elapsed` s after the reporter started
+         */
+        void printLine(const ProgressSnapshot& snapshot, double elapsed);
+
+        /**
+         * @brief The reporter's thread: asks for a snapshot every `interval` s and prints it, until the reporter is stopped
+         */
+        void run();
+
+    public:
+        /**
+         * @brief Creates a reporter which prints a status line every `intervalSeconds` seconds once it's started
+         */
+        ProgressReporter(double intervalSeconds);
+
+        /**
+         * @brief Stops the reporter if it's running
+         */
+        ~ProgressReporter();
+
+        ProgressReporter(const ProgressReporter&) = delete;
+        ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+        /**
+         * @brief Starts the reporter's thread, and its clock
+         */
+        void start();
+
+        /**
+         * @brief Stops the reporter's thread, without printing anything more
+         */
+        void stop();
+
+        /**
+         * @brief Checks if the reporter is waiting for a snapshot
+         */
+        bool isSnapshotRequested() { return requested.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Publishes the state of the search(its `time` is filled in), which answers the reporter's request
+         */
+        void publish(const ProgressSnapshot& snapshot);
+};
+
+#endif
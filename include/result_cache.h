@@ -0,0 +1,64 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "bb_utils.h"
+#include "lp.h"
+
+#include <string>
+#include <cstdint>
+
+#define RESULT_CACHE_VERSION 2
+
+typedef struct {
+    ProblemStatus status;
+    double bound;                  // objective function value of the optimal solution(0 if there is none)
+    PerformanceMetrics metrics;
+}CachedResult;
+
+class ResultCache {
+    private:
+        std::string directory;
+
+        /**
+         * @brief Returns the name of the file which stores the result whose key is `key`
+         */
+        std::string getEntryFileName(const std::string& key);
+
+    public:
+        /**
+         * @brief Constructs a result cache which stores one file per result in `directory`, creating it if needed
+         *
+         * @throw std::invalid_argument - if the directory can't be created
+         */
+        ResultCache(const std::string& cacheDirectory);
+
+        /**
+         * @brief Returns the default cache directory: $XDG_CACHE_HOME/linsolve, or ~/.cache/linsolve. Returns an empty string if neither
+         *        variable is set
+         */
+        static std::string defaultDirectory();
+
+        /**
+         * @brief Returns the version of the running solver: the cache format version and a build id taken from the executable's size and
+         *        modification time, so rebuilding the solver never serves the results of the previous build
+         */
+        static std::string getSolverVersion();
+
+        /**
+         * @brief Looks up the result whose key is `key`. Missing, unreadable and outdated entries, and entries whose stored model check isn't
+         *        `modelCheck`(another model with the same key), are cache misses
+         *
+         * @return true if the result was found, in which case it's stored in `result`
+         */
+        bool lookup(const std::string& key, uint64_t modelCheck, CachedResult& result);
+
+        /**
+         * @brief Stores `result` under `key`, along with the model check it's looked up with, replacing any previous entry. The entry is written under a temporary name and then renamed,
+         *        so concurrent solves never read a partial entry
+         *
+         * @throw std::invalid_argument - if the entry can't be written
+         */
+        void store(const std::string& key, uint64_t modelCheck, const CachedResult& result);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SCALING_H
+#define SCALING_H
+
+#include "lp.h"
+
+#include <vector>
+
+#define GEOMETRIC_SCALING_PASSES 8
+
+typedef struct {
+    std::vector<double> rowScale;       // row i of the model is multiplied by rowScale[i]
+    std::vector<double> columnScale;    // x[j] = columnScale[j] * x'[j]
+    double qualityBefore;
+    double qualityAfter;
+}ScalingFactors;
+
+/**
+ * @brief Returns the ratio between the largest and the smallest absolute value of the constraints' non zero coefficients.
+ *        The closer it is to 1, the better scaled the model is
+ */
+double scalingQuality(LpProblem& problem);
+
+/**
+ * @brief Computes row and column scaling factors for `problem`: a few geometric mean passes, which bring the coefficients of each
+ *        row and column around 1, followed by an equilibration pass, which makes the largest coefficient of each column and row 1.
+ *        All factors are powers of 2, so scaling doesn't introduce any rounding errors
+ */
+ScalingFactors computeScalingFactors(LpProblem& problem);
+
+/**
+ * @brief Scales the constraints and objective function of `problem` by `factors`
+ */
+void applyScaling(LpProblem& problem, const ScalingFactors& factors);
+
+/**
+ * @brief Maps a solution of the scaled problem back to the variables of the unscaled problem
+ */
+void unscaleSolution(Matrix& solution, const ScalingFactors& factors);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef SHARED_INCUMBENT_H
+#define SHARED_INCUMBENT_H
+
+#include "lp.h"
+#include "matrix.h"
+
+#include <mutex>
+#include <atomic>
+
+class SharedIncumbent {
+    private:
+        ProblemType type;
+        std::mutex mutex;
+        bool hasSolution;
+        double value;
+        Matrix solution;
+        std::atomic<bool> stopped;
+
+    public:
+        /**
+         * @brief Constructs an empty incumbent, for a maximization(MAX) or minimization(MIN) problem
+         */
+        SharedIncumbent(ProblemType problemType);
+
+        /**
+         * @brief Replaces the incumbent by `newSolution` if its objective function value(`newValue`) is better
+         *
+         * @return true if the incumbent was replaced
+         */
+        bool offer(double newValue, const Matrix& newSolution);
+
+        /**
+         * @brief Checks if `candidateValue` is better than the incumbent's objective function value(always true if there is no incumbent yet)
+         */
+        bool isBetter(double candidateValue);
+
+        /**
+         * @brief Checks if any solution was offered
+         */
+        bool hasIncumbent();
+
+        /**
+         * @brief Returns the incumbent's objective function value
+         */
+        double getValue();
+
+        /**
+         * @brief Returns the incumbent solution, in the original problem's variables
+         */
+        Matrix getSolution();
+
+        /**
+         * @brief Asks every search sharing this incumbent to stop
+         */
+        void stop() { stopped = true; }
+
+        /**
+         * @brief Checks if the searches sharing this incumbent were asked to stop
+         */
+        bool isStopped() { return stopped.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef SPARSE_MODEL_H
+#define SPARSE_MODEL_H
+
+#include "lp.h"
+#include "constraint.h"
+
+#include <vector>
+#include <string>
+#include <sys/types.h>
+
+typedef struct {
+    std::string name;
+    ProblemType type;
+    std::vector<std::string> rowNames;
+    std::vector<std::string> columnNames;
+
+    std::vector<ConstraintType> rowTypes;
+    std::vector<double> rhs;
+    std::vector<double> ranges;          // NAN if the row isn't ranged
+
+    std::vector<double> objective;
+    double objectiveOffset;
+
+    // constraint matrix, in compressed sparse column form: the entries of column j are [columnStart[j], columnStart[j + 1])
+    std::vector<uint> columnStart;
+    std::vector<uint> rowIndex;
+    std::vector<double> values;
+
+    std::vector<double> lowerBounds;
+    std::vector<double> upperBounds;
+    std::vector<bool> integer;
+}SparseModel;
+
+// constraint matrix entries, as (row, column, value) triplets. The rows are relative to `rowOffset`, so a buffer can be filled
+// before the number of rows preceding its entries is known
+typedef struct {
+    std::vector<uint> rows;
+    std::vector<uint> columns;
+    std::vector<double> values;
+    uint rowOffset;
+}TripletBuffer;
+
+/**
+ * @brief Returns an empty sparse model(no rows nor columns)
+ */
+SparseModel emptySparseModel();
+
+/**
+ * @brief Returns an empty triplet buffer, whose rows start at `rowOffset`
+ */
+TripletBuffer emptyTripletBuffer(uint rowOffset = 0);
+
+/**
+ * @brief Sets the constraint matrix of `model` from the triplets of `buffers`, in any order. The entries of each column end up
+ *        sorted by row, with duplicate entries summed and zeros removed. The model must already have all its columns
+ */
+void setMatrixFromTriplets(SparseModel& model, const std::vector<TripletBuffer>& buffers);
+
+/**
+ * @brief Same as above, for a single buffer
+ */
+void setMatrixFromTriplets(SparseModel& model, const TripletBuffer& triplets);
+
+/**
+ * @brief Builds the dense LP model used by the solver from `model`. Ranged rows become two constraints, and the variables' bounds
+ *        are set on the LP model
+ *
+ * @throw std::invalid_argument - if a variable has no finite lower bound, which the solver doesn't support
+ */
+LpProblem sparseModelToLpProblem(const SparseModel& model);
+
+#endif
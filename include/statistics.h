@@ -0,0 +1,34 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <vector>
+
+// summary of a set of samples(e.g. the execution times of a benchmark's runs)
+typedef struct {
+    double min;
+    double median;
+    double p90;
+    double p99;
+    double mean;
+    double stddev;
+}SampleStatistics;
+
+/**
+ * @brief Returns the `fraction`(between 0 and 1) percentile of `sorted`, a non empty list of samples in ascending order, interpolating
+ *        linearly between the two closest ranks
+ */
+double percentile(const std::vector<double>& sorted, double fraction);
+
+/**
+ * @brief Returns the minimum, median, 90th and 99th percentiles, mean and sample standard deviation of `samples`(all 0 if it's empty)
+ */
+SampleStatistics computeStatistics(std::vector<double> samples);
+
+/**
+ * @brief Returns the two sided p-value of the Mann-Whitney U test of `first` and `second`: the probability that samples as different as
+ *        these come from the same distribution. Uses the normal approximation, with tie and continuity corrections, so it needs a few
+ *        samples on each side to reach small p-values. Returns 1 if either list is empty or every sample is equal
+ */
+double mannWhitneyPValue(const std::vector<double>& first, const std::vector<double>& second);
+
+#endif
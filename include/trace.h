@@ -0,0 +1,114 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+// events each thread keeps. A thread's ring buffer grows with its events up to this size(1.2 MB), after which its oldest events are
+// overwritten(and counted as dropped)
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE (1 << 14)
+#endif
+
+// one event of a thread: a complete event('X', with a duration) or an instant event('i'). Names are string literals, so recording an
+// event never allocates
+typedef struct {
+    const char* name;
+    const char* category;
+    char type;
+    uint64_t start;             // ns since the trace started
+    uint64_t duration;          // ns
+    const char* argNames[2];    // NULL if the argument isn't used
+    double args[2];
+}TraceEvent;
+
+// timeline of the solver(phases, node solves, branching decisions, incumbent updates, ...) of every thread, written in the Chrome
+// trace event format(chrome://tracing, https://ui.perfetto.dev). Each thread records its events in its own ring buffer, without locks.
+// Recording costs a relaxed atomic load while tracing is disabled, and nothing in builds without tracing(make TRACE=0, which defines
+// NO_TRACE and turns the TRACE_ macros below into nothing)
+class Tracer {
+    private:
+        static std::atomic<bool> enabled;
+        static std::chrono::steady_clock::time_point origin;
+
+    public:
+        /**
+         * @brief Enables tracing, from now on. Timestamps are relative to the first call
+         */
+        static void start();
+
+        static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns the ns elapsed since the trace started
+         */
+        static uint64_t now();
+
+        /**
+         * @brief Records an event on the calling thread's ring buffer
+         */
+        static void record(const TraceEvent& event);
+
+        /**
+         * @brief Records an instant event, with up to two arguments(pass NULL names for unused ones)
+         */
+        static void instant(const char* name, const char* category, const char* argName1 = NULL, double arg1 = 0, const char* argName2 = NULL, double arg2 = 0);
+
+        /**
+         * @brief Names the calling thread in the trace(e.g. after the strategies a portfolio tree runs)
+         */
+        static void setThreadName(const std::string& name);
+
+        /**
+         * @brief Writes the events of every thread to the file `fileName`, in the Chrome trace event format, and releases their ring buffers.
+         *        Threads mustn't record events while the trace is written
+         *
+         * @throw std::invalid_argument - if the file can't be written
+         */
+        static void write(const std::string& fileName);
+};
+
+// records the time between its construction and its destruction as a complete event, if tracing was enabled when it was constructed.
+// Both are inline, so a disabled scope only costs the enabled check
+class TraceScope {
+    private:
+        TraceEvent event;
+        bool active;
+
+    public:
+        TraceScope(const char* name, const char* category, const char* argName1 = NULL, double arg1 = 0, const char* argName2 = NULL, double arg2 = 0) {
+            active = Tracer::isEnabled();
+            if(!active) return;
+
+            event = {name, category, 'X', Tracer::now(), 0, {argName1, argName2}, {arg1, arg2}};
+        }
+
+        ~TraceScope() {
+            if(!active) return;
+
+            event.duration = Tracer::now() - event.start;
+            Tracer::record(event);
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#ifndef NO_TRACE
+// traces the rest of the enclosing scope, e.g. TRACE_SCOPE("presolve", "phase") or TRACE_SCOPE("node", "node", "number", n, "depth", d)
+#define TRACE_SCOPE(...) TraceScope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+#define TRACE_INSTANT(...) do { if(Tracer::isEnabled()) Tracer::instant(__VA_ARGS__); } while(0)
+#define TRACE_THREAD_NAME(name) do { if(Tracer::isEnabled()) Tracer::setThreadName(name); } while(0)
+#else
+// the arguments are kept in unevaluated operands, so they're still type checked and variables only traced don't become unused
+#define TRACE_SCOPE(...) do { (void)sizeof(TraceScope(__VA_ARGS__)); } while(0)
+#define TRACE_INSTANT(...) do { (void)sizeof((Tracer::instant(__VA_ARGS__), 0)); } while(0)
+#define TRACE_THREAD_NAME(name) do { (void)sizeof(name); } while(0)
+#endif
+
+#endif
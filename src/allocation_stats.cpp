@@ -0,0 +1,125 @@
+#include "allocation_stats.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+namespace {
+
+std::atomic<int> runningCounters(0);
+std::atomic<uint64_t> allocationCount(0);
+std::atomic<uint64_t> allocatedBytes(0);
+
+// the live bytes are those of the blocks(their usable size) allocated minus those freed while tracking, so blocks allocated before the
+// tracking started and freed during it make them drop. Only their growth means something
+std::atomic<int64_t> liveBytes(0);
+
+// the peak of the live bytes of each running counter, since it was started. A counter's bit is set in usedSlots while it runs
+std::atomic<uint64_t> usedSlots(0);
+std::atomic<int64_t> slotPeaks[ALLOCATION_COUNTER_SLOTS];
+
+void raisePeak(std::atomic<int64_t>& peak, int64_t live) {
+    int64_t current = peak.load(std::memory_order_relaxed);
+    while(live > current && !peak.compare_exchange_weak(current, live, std::memory_order_relaxed));
+}
+
+void trackAllocation(void* pointer, size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    int64_t blockSize = malloc_usable_size(pointer);
+    int64_t live = liveBytes.fetch_add(blockSize, std::memory_order_relaxed) + blockSize;
+    for(uint64_t slots = usedSlots.load(std::memory_order_relaxed); slots != 0; slots &= slots - 1) {
+        raisePeak(slotPeaks[__builtin_ctzll(slots)], live);
+    }
+}
+
+// claims a free slot, whose peak starts at `live`. Returns -1 if every slot is taken
+int claimSlot(int64_t live) {
+    uint64_t slots = usedSlots.load();
+    while(~slots != 0) {
+        int slot = __builtin_ctzll(~slots);
+        if(usedSlots.compare_exchange_weak(slots, slots | (1ULL << slot))) {
+            slotPeaks[slot] = live;
+            return slot;
+        }
+    }
+    return -1;
+}
+
+}
+
+AllocationStats emptyAllocationStats() {
+    return {0, 0, 0, false};
+}
+
+void addAllocationStats(AllocationStats& total, const AllocationStats& stats) {
+    if(!stats.available) return;
+
+    total.allocations += stats.allocations;
+    total.bytes += stats.bytes;
+    if(stats.peakLiveBytes > total.peakLiveBytes) total.peakLiveBytes = stats.peakLiveBytes;
+    total.available = true;
+}
+
+AllocationCounter::AllocationCounter() {
+    startAllocations = 0;
+    startBytes = 0;
+    startLiveBytes = 0;
+    slot = -1;
+    running = false;
+}
+
+AllocationCounter::~AllocationCounter() {
+    if(running) stop();
+}
+
+void AllocationCounter::start() {
+    if(running) return;
+
+    runningCounters.fetch_add(1);
+    startAllocations = allocationCount;
+    startBytes = allocatedBytes;
+    startLiveBytes = liveBytes;
+    slot = claimSlot(startLiveBytes);
+    running = true;
+}
+
+AllocationStats AllocationCounter::stop() {
+    if(!running) return emptyAllocationStats();
+
+    AllocationStats stats;
+    stats.allocations = allocationCount - startAllocations;
+    stats.bytes = allocatedBytes - startBytes;
+    int64_t peak = (slot >= 0) ? slotPeaks[slot].load() : liveBytes.load();
+    stats.peakLiveBytes = (peak > startLiveBytes) ? peak - startLiveBytes : 0;
+    stats.available = true;
+
+    if(slot >= 0) usedSlots.fetch_and(~(1ULL << slot));
+    slot = -1;
+    runningCounters.fetch_sub(1);
+    running = false;
+    return stats;
+}
+
+// the array, nothrow and sized forms of the standard library forward to these
+
+void* operator new(size_t size) {
+    void* pointer = std::malloc(size ? size : 1);
+    if(pointer == NULL) throw std::bad_alloc();
+
+    if(runningCounters.load(std::memory_order_relaxed) > 0) trackAllocation(pointer, size);
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    if(pointer != NULL && runningCounters.load(std::memory_order_relaxed) > 0) {
+        liveBytes.fetch_sub(malloc_usable_size(pointer), std::memory_order_relaxed);
+    }
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
@@ -0,0 +1,383 @@
+#include "barrier.h"
+
+#include <cmath>
+#include <algorithm>
+#include <queue>
+#include <cstdint>
+
+namespace {
+
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double result = 0;
+    for(uint i = 0; i < a.size(); i++) result += a[i] * b[i];
+    return result;
+}
+
+double norm(const std::vector<double>& a) {
+    return std::sqrt(dot(a, a));
+}
+
+}
+
+// PRIVATE METHODS
+
+void BarrierSolver::buildStandardForm(LpProblem& problem) {
+    std::vector<Constraint>& constraints = problem.getConstraints();
+    nRows = constraints.size();
+    nStructural = problem.getObjectiveFunction().getNColumns();
+
+    columns.assign(nStructural, {});
+    b.resize(nRows);
+    c.assign(nStructural, 0.0);
+
+    double sign = (problem.getType() == MAX) ? -1 : 1;
+    for(uint j = 0; j < nStructural; j++) c[j] = sign * problem.getObjectiveFunction().getElement(0, j);
+
+    for(uint i = 0; i < nRows; i++) {
+        std::vector<double>& lhs = constraints[i].getLhs();
+        for(uint j = 0; j < nStructural; j++) {
+            if(lhs[j] != 0) columns[j].push_back(std::make_pair(i, lhs[j]));
+        }
+        b[i] = constraints[i].getRhs();
+
+        if(constraints[i].getType() == LESS_THAN_OR_EQUAL) {
+            columns.push_back({std::make_pair(i, 1.0)});
+            c.push_back(0);
+        }
+        else if(constraints[i].getType() == GREATER_THAN_OR_EQUAL) {
+            columns.push_back({std::make_pair(i, -1.0)});
+            c.push_back(0);
+        }
+    }
+
+    nColumns = columns.size();
+
+    rows.assign(nRows, {});
+    for(uint j = 0; j < nColumns; j++) {
+        for(const std::pair<uint, double>& entry : columns[j]) rows[entry.first].push_back(std::make_pair(j, entry.second));
+    }
+}
+
+std::vector<double> BarrierSolver::multiplyA(const std::vector<double>& v) {
+    std::vector<double> result(nRows, 0.0);
+    for(uint j = 0; j < nColumns; j++) {
+        if(v[j] == 0) continue;
+        for(const std::pair<uint, double>& entry : columns[j]) result[entry.first] += entry.second * v[j];
+    }
+    return result;
+}
+
+std::vector<double> BarrierSolver::multiplyATranspose(const std::vector<double>& v) {
+    std::vector<double> result(nColumns, 0.0);
+    for(uint j = 0; j < nColumns; j++) {
+        for(const std::pair<uint, double>& entry : columns[j]) result[j] += entry.second * v[entry.first];
+    }
+    return result;
+}
+
+void BarrierSolver::analyzeNormalMatrix() {
+    // graph of A*A^T: two rows are adjacent if a column of A has entries in both. Rows already added to a row's neighbors are stamped
+    // with it, so each one is only added once
+    std::vector<std::vector<uint>> adjacency(nRows);
+    std::vector<uint64_t> stamps(nRows, 0);
+    uint64_t stamp = 0;
+    for(uint i = 0; i < nRows; i++) {
+        stamp++;
+        stamps[i] = stamp;
+        for(const std::pair<uint, double>& rowEntry : rows[i]) {
+            for(const std::pair<uint, double>& entry : columns[rowEntry.first]) {
+                if(stamps[entry.first] == stamp) continue;
+                stamps[entry.first] = stamp;
+                adjacency[i].push_back(entry.first);
+            }
+        }
+    }
+
+    // rows by degree, with stale entries skipped when they come up
+    std::priority_queue<std::pair<uint, uint>, std::vector<std::pair<uint, uint>>, std::greater<std::pair<uint, uint>>> candidates;
+    for(uint i = 0; i < nRows; i++) candidates.push(std::make_pair(adjacency[i].size(), i));
+
+    // eliminating a row turns its neighbors into a clique, and its neighbors at that point are the rows of its column of L. The
+    // neighbors of each of them are stamped the same way before the clique is added
+    std::vector<bool> eliminated(nRows, false);
+    std::vector<std::vector<uint>> factorPattern(nRows);
+    eliminationOrder.clear();
+    while(!candidates.empty()) {
+        std::pair<uint, uint> candidate = candidates.top();
+        candidates.pop();
+        uint row = candidate.second;
+        if(eliminated[row] || candidate.first != adjacency[row].size()) continue;
+
+        eliminated[row] = true;
+        eliminationOrder.push_back(row);
+        std::vector<uint>& neighbors = adjacency[row];
+        for(uint neighbor : neighbors) {
+            std::vector<uint>& neighborAdjacency = adjacency[neighbor];
+            stamp++;
+            stamps[neighbor] = stamp;
+
+            uint kept = 0;
+            for(uint other : neighborAdjacency) {
+                if(other == row) continue;
+                neighborAdjacency[kept++] = other;
+                stamps[other] = stamp;
+            }
+            neighborAdjacency.resize(kept);
+            for(uint other : neighbors) {
+                if(stamps[other] != stamp) neighborAdjacency.push_back(other);
+            }
+            candidates.push(std::make_pair(neighborAdjacency.size(), neighbor));
+        }
+        factorPattern[row].swap(neighbors);
+        neighbors.shrink_to_fit();
+    }
+
+    eliminationStep.resize(nRows);
+    for(uint k = 0; k < nRows; k++) eliminationStep[eliminationOrder[k]] = k;
+
+    factorStart.assign(1, 0);
+    factorRows.clear();
+    for(uint k = 0; k < nRows; k++) {
+        std::vector<uint>& pattern = factorPattern[eliminationOrder[k]];
+        for(uint& neighbor : pattern) neighbor = eliminationStep[neighbor];
+        std::sort(pattern.begin(), pattern.end());
+
+        factorRows.push_back(k);
+        factorRows.insert(factorRows.end(), pattern.begin(), pattern.end());
+        factorStart.push_back(factorRows.size());
+        std::vector<uint>().swap(pattern);
+    }
+    factorValues.resize(factorRows.size());
+}
+
+void BarrierSolver::factorNormalMatrix(const std::vector<double>& d) {
+    droppedPivots.assign(nRows, false);
+
+    double maxDiagonal = 0;
+    for(uint i = 0; i < nRows; i++) {
+        double diagonal = 0;
+        for(const std::pair<uint, double>& entry : rows[i]) diagonal += entry.second * d[entry.first] * entry.second;
+        maxDiagonal = std::max(maxDiagonal, diagonal);
+    }
+
+    // left looking: column k of L is column k of P*A*D*A^T minus the columns of L with an entry in row k. Each column of L waits in the
+    // list of the next row it updates(nextEntry), so the columns updating row k are the ones listed there when it's reached
+    std::vector<double> work(nRows, 0.0);
+    std::vector<uint> nextEntry(nRows);
+    std::vector<int> firstWaiting(nRows, -1), nextWaiting(nRows, -1);
+    for(uint k = 0; k < nRows; k++) {
+        uint row = eliminationOrder[k];
+        for(const std::pair<uint, double>& rowEntry : rows[row]) {
+            double scaled = rowEntry.second * d[rowEntry.first];
+            for(const std::pair<uint, double>& entry : columns[rowEntry.first]) {
+                uint step = eliminationStep[entry.first];
+                if(step >= k) work[step] += scaled * entry.second;
+            }
+        }
+
+        int column = firstWaiting[k];
+        while(column != -1) {
+            int following = nextWaiting[column];
+            uint start = nextEntry[column], end = factorStart[column + 1];
+            double multiplier = factorValues[start];
+            for(uint p = start; p < end; p++) work[factorRows[p]] -= factorValues[p] * multiplier;
+
+            if(++nextEntry[column] < end) {
+                uint nextRow = factorRows[nextEntry[column]];
+                nextWaiting[column] = firstWaiting[nextRow];
+                firstWaiting[nextRow] = column;
+            }
+            column = following;
+        }
+
+        uint start = factorStart[k], end = factorStart[k + 1];
+        double pivot = work[k];
+        if(pivot <= 1e-14 * maxDiagonal || pivot <= 0) {
+            droppedPivots[k] = true;
+            factorValues[start] = 1;
+            for(uint p = start + 1; p < end; p++) factorValues[p] = 0;
+        }
+        else {
+            double diagonal = std::sqrt(pivot);
+            factorValues[start] = diagonal;
+            for(uint p = start + 1; p < end; p++) factorValues[p] = work[factorRows[p]] / diagonal;
+        }
+        for(uint p = start; p < end; p++) work[factorRows[p]] = 0;
+
+        nextEntry[k] = start + 1;
+        if(start + 1 < end) {
+            uint nextRow = factorRows[start + 1];
+            nextWaiting[k] = firstWaiting[nextRow];
+            firstWaiting[nextRow] = k;
+        }
+    }
+}
+
+std::vector<double> BarrierSolver::solveNormalEquations(const std::vector<double>& rhs) {
+    std::vector<double> z(nRows);
+    for(uint k = 0; k < nRows; k++) z[k] = rhs[eliminationOrder[k]];
+
+    // L*z = P*rhs
+    for(uint k = 0; k < nRows; k++) {
+        if(droppedPivots[k]) {
+            z[k] = 0;
+            continue;
+        }
+        z[k] /= factorValues[factorStart[k]];
+        for(uint p = factorStart[k] + 1; p < factorStart[k + 1]; p++) z[factorRows[p]] -= factorValues[p] * z[k];
+    }
+
+    // L^T*z' = z
+    for(int k = nRows - 1; k >= 0; k--) {
+        if(droppedPivots[k]) {
+            z[k] = 0;
+            continue;
+        }
+        for(uint p = factorStart[k] + 1; p < factorStart[k + 1]; p++) z[k] -= factorValues[p] * z[factorRows[p]];
+        z[k] /= factorValues[factorStart[k]];
+    }
+
+    std::vector<double> solution(nRows);
+    for(uint k = 0; k < nRows; k++) solution[eliminationOrder[k]] = z[k];
+    return solution;
+}
+
+void BarrierSolver::initialPoint() {
+    factorNormalMatrix(std::vector<double>(nColumns, 1.0));
+
+    // x = A^T*(A*A^T)^-1*b, y = (A*A^T)^-1*A*c, s = c - A^T*y
+    x = multiplyATranspose(solveNormalEquations(b));
+    y = solveNormalEquations(multiplyA(c));
+    s = multiplyATranspose(y);
+    for(uint j = 0; j < nColumns; j++) s[j] = c[j] - s[j];
+
+    double xShift = std::max(-1.5 * *std::min_element(x.begin(), x.end()), 0.0);
+    double sShift = std::max(-1.5 * *std::min_element(s.begin(), s.end()), 0.0);
+    for(uint j = 0; j < nColumns; j++) {
+        x[j] += xShift;
+        s[j] += sShift;
+    }
+
+    double xSum = 0, sSum = 0;
+    for(uint j = 0; j < nColumns; j++) {
+        xSum += x[j];
+        sSum += s[j];
+    }
+    double xs = dot(x, s);
+
+    // degenerate starting points(e.g. a null objective function) are pushed away from the boundary by a fixed amount
+    if(xSum <= 0 || sSum <= 0 || xs <= 0) {
+        for(uint j = 0; j < nColumns; j++) {
+            x[j] += 1;
+            s[j] += 1;
+        }
+        return;
+    }
+
+    for(uint j = 0; j < nColumns; j++) {
+        x[j] += 0.5 * xs / sSum;
+        s[j] += 0.5 * xs / xSum;
+    }
+}
+
+void BarrierSolver::searchDirection(const std::vector<double>& rp, const std::vector<double>& rd, const std::vector<double>& rc,
+                                    std::vector<double>& dx, std::vector<double>& dy, std::vector<double>& ds) {
+    // (A*D*A^T)*dy = rp + A*(D*rd - rc/s), with D = x/s
+    std::vector<double> aux(nColumns);
+    for(uint j = 0; j < nColumns; j++) aux[j] = (x[j] * rd[j] - rc[j]) / s[j];
+
+    std::vector<double> rhs = multiplyA(aux);
+    for(uint i = 0; i < nRows; i++) rhs[i] += rp[i];
+
+    dy = solveNormalEquations(rhs);
+    ds = multiplyATranspose(dy);
+    dx.resize(nColumns);
+    for(uint j = 0; j < nColumns; j++) {
+        ds[j] = rd[j] - ds[j];
+        dx[j] = (rc[j] - x[j] * ds[j]) / s[j];
+    }
+}
+
+double BarrierSolver::maxStepLength(const std::vector<double>& v, const std::vector<double>& dv) {
+    double step = INFINITY;
+    for(uint j = 0; j < v.size(); j++) {
+        if(dv[j] < 0) step = std::min(step, -v[j] / dv[j]);
+    }
+    return step;
+}
+
+// PUBLIC METHODS
+
+BarrierSolver::BarrierSolver(LpProblem& problem) {
+    buildStandardForm(problem);
+    analyzeNormalMatrix();
+    iterations = 0;
+    cancelFlag = problem.getCancelFlag();
+}
+
+ProblemStatus BarrierSolver::solve() {
+    iterations = 0;
+    if(nRows == 0) return NOT_YET_SOLVED;
+
+    initialPoint();
+
+    double bNorm = norm(b), cNorm = norm(c);
+    std::vector<double> rp(nRows), rd(nColumns), rc(nColumns);
+    std::vector<double> dxAffine, dyAffine, dsAffine, dx, dy, ds;
+
+    for(iterations = 0; iterations < BARRIER_MAX_ITERATIONS; iterations++) {
+        if(cancelFlag != NULL && cancelFlag->load(std::memory_order_relaxed)) return NOT_YET_SOLVED;
+
+        std::vector<double> ax = multiplyA(x);
+        std::vector<double> aty = multiplyATranspose(y);
+        for(uint i = 0; i < nRows; i++) rp[i] = b[i] - ax[i];
+        for(uint j = 0; j < nColumns; j++) rd[j] = c[j] - aty[j] - s[j];
+
+        double primalObjective = dot(c, x), dualObjective = dot(b, y);
+        double mu = dot(x, s) / nColumns;
+
+        if(norm(rp) / (1 + bNorm) < BARRIER_TOLERANCE && norm(rd) / (1 + cNorm) < BARRIER_TOLERANCE &&
+           std::fabs(primalObjective - dualObjective) / (1 + std::fabs(primalObjective)) < BARRIER_TOLERANCE) {
+            return CONTINUOUS_SOLUTION;
+        }
+
+        if(norm(x) > BARRIER_DIVERGENCE || norm(y) > BARRIER_DIVERGENCE || !std::isfinite(mu)) return NOT_YET_SOLVED;
+
+        std::vector<double> d(nColumns);
+        for(uint j = 0; j < nColumns; j++) d[j] = x[j] / s[j];
+        factorNormalMatrix(d);
+
+        // predictor(affine scaling direction)
+        for(uint j = 0; j < nColumns; j++) rc[j] = -x[j] * s[j];
+        searchDirection(rp, rd, rc, dxAffine, dyAffine, dsAffine);
+
+        double primalStep = std::min(1.0, maxStepLength(x, dxAffine)), dualStep = std::min(1.0, maxStepLength(s, dsAffine));
+        double affineMu = 0;
+        for(uint j = 0; j < nColumns; j++) affineMu += (x[j] + primalStep * dxAffine[j]) * (s[j] + dualStep * dsAffine[j]);
+        affineMu /= nColumns;
+
+        // corrector, centered according to how much progress the predictor would make
+        double sigma = std::pow(affineMu / mu, 3);
+        for(uint j = 0; j < nColumns; j++) rc[j] = sigma * mu - x[j] * s[j] - dxAffine[j] * dsAffine[j];
+        searchDirection(rp, rd, rc, dx, dy, ds);
+
+        primalStep = std::min(1.0, BARRIER_STEP_FRACTION * maxStepLength(x, dx));
+        dualStep = std::min(1.0, BARRIER_STEP_FRACTION * maxStepLength(s, ds));
+
+        for(uint j = 0; j < nColumns; j++) {
+            x[j] += primalStep * dx[j];
+            s[j] += dualStep * ds[j];
+        }
+        for(uint i = 0; i < nRows; i++) y[i] += dualStep * dy[i];
+    }
+
+    return NOT_YET_SOLVED;
+}
+
+std::vector<double> BarrierSolver::getSolution() {
+    return std::vector<double>(x.begin(), x.begin() + nStructural);
+}
+
+std::vector<double> BarrierSolver::getReducedCosts() {
+    return std::vector<double>(s.begin(), s.begin() + nStructural);
+}
@@ -12,6 +12,7 @@ BaBNode::BaBNode(const LpProblem& nodeProblem, uint newDepth) {
     rightChild = nullptr;
     status = NOT_EVALUATED;
     depth = newDepth;
+    id = 0;
 }
 
 BaBNode::BaBNode(const BaBNode& otherNode) {
@@ -20,6 +21,7 @@ BaBNode::BaBNode(const BaBNode& otherNode) {
     rightChild = otherNode.rightChild;
     status = otherNode.status;
     depth = otherNode.depth;
+    id = otherNode.id;
 }
 
 std::pair<uint, double> BaBNode::getBranchVariableInfo(BranchingStrategy branchStrat) {
@@ -101,10 +103,8 @@ BaBNode* BaBNode::branchLeft(int varIndex, double varValue) {
         throw std::invalid_argument(errorMsg.str());
     }
 
-    std::vector<double> newLhs = basisVector(problem.getObjectiveFunction().getNColumns(), varIndex).getElements();
-    Constraint newConstraint(newLhs, "<=", floor(varValue));
     LpProblem newProblem = problem;
-    newProblem.addConstraint(newConstraint);
+    newProblem.tightenVariableBounds(varIndex, -INFINITY, floor(varValue));
     leftChild = new BaBNode(newProblem, depth + 1);
 
     return leftChild;
@@ -118,10 +118,8 @@ BaBNode* BaBNode::branchRight(int varIndex, double varValue) {
         throw std::invalid_argument(errorMsg.str());
     }
 
-    std::vector<double> newLhs = basisVector(problem.getObjectiveFunction().getNColumns(), varIndex).getElements();
-    Constraint newConstraint(newLhs, ">=", ceil(varValue));
     LpProblem newProblem = problem;
-    newProblem.addConstraint(newConstraint);
+    newProblem.tightenVariableBounds(varIndex, ceil(varValue), INFINITY);
     rightChild = new BaBNode(newProblem, depth + 1);
 
     return rightChild;
@@ -1,4 +1,7 @@
 #include "bb_tree.h"
+#include "model_writer.h"
+#include "memory_usage.h"
+#include "trace.h"
 
 #include <iostream>
 #include <cmath>
@@ -6,23 +9,46 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <thread>
+#include <atomic>
+#include <sstream>
+
+namespace {
+
+// prints `ms` in s, ms or us, whichever is the most readable
+void displayTime(double ms) {
+    if(ms > 1000) std::cout << ms / 1000 << " s";
+    else if(ms < 1) std::cout << ms * 1000 << " us";
+    else std::cout << ms << " ms";
+}
+
+}
 
 // PRIVATE METHODS
 
 void BaBTree::fathomLeafNodes(std::vector<BaBNode*>& nodeQueue, ExplorationStrategy strategy, BaBNode*& incumbentSolution) {
     for(int i = nodeQueue.size() - 1; i >= 0; i--) {
         if(*nodeQueue[i] == UNBOUNDED || *nodeQueue[i] == INFEASIBLE) {
+            recordFate(nodeQueue[i], (*nodeQueue[i] == UNBOUNDED) ? NODE_UNBOUNDED : NODE_INFEASIBLE);
             *nodeQueue[i] = FATHOMED;
             nodeQueue.erase(nodeQueue.begin() + i);
         }
         else if(*nodeQueue[i] == WHOLE_SOLUTION) {
             updateIncumbentSolution(nodeQueue[i], incumbentSolution);
+            recordFate(nodeQueue[i], NODE_INTEGRAL);
             *nodeQueue[i] = FATHOMED;
             nodeQueue.erase(nodeQueue.begin() + i);
         }
         else if(*nodeQueue[i] == CONTINUOUS_SOLUTION) {
             if(strategy != ExplorationStrategy::EXPLORE_ALL_NODES) {
                 if(incumbentSolution != NULL && !nodeQueue[i]->isBetter(incumbentSolution)) {
+                    recordFate(nodeQueue[i], NODE_PRUNED);
+                    *nodeQueue[i] = FATHOMED;
+                    nodeQueue.erase(nodeQueue.begin() + i);
+                }
+                else if(sharedIncumbent != NULL &&
+                        !sharedIncumbent->isBetter(nodeQueue[i]->getObjectiveFunctionValue() + postsolveStack->getObjectiveOffset())) {
+                    recordFate(nodeQueue[i], NODE_PRUNED);
                     *nodeQueue[i] = FATHOMED;
                     nodeQueue.erase(nodeQueue.begin() + i);
                 }
@@ -32,18 +58,113 @@ void BaBTree::fathomLeafNodes(std::vector<BaBNode*>& nodeQueue, ExplorationStrat
 }
 
 void BaBTree::updateIncumbentSolution(BaBNode* candidate, BaBNode*& incumbentSolution) {
-   if(incumbentSolution == NULL || candidate->isBetter(incumbentSolution)) incumbentSolution = candidate;
+    if(incumbentSolution == NULL || candidate->isBetter(incumbentSolution)) {
+        incumbentSolution = candidate;
+        TRACE_INSTANT("incumbent", "search", "objective", candidate->getObjectiveFunctionValue() + postsolveStack->getObjectiveOffset(), "depth", candidate->getDepth());
+        if(sharedIncumbent != NULL) {
+            sharedIncumbent->offer(candidate->getObjectiveFunctionValue() + postsolveStack->getObjectiveOffset(), getOriginalSolution(candidate));
+        }
+    }
+}
+
+void BaBTree::dumpModel(LpProblem& problem, const std::string& name) {
+    if(dumpDirectory.empty()) return;
+    ModelFileWriter::writeModel(problem, dumpDirectory + "/" + name + dumpExtension);
 }
 
 void BaBTree::solveNodeQueue(std::vector<BaBNode*>& nodeQueue, uint& solvedNodes) {
     for(uint i = 0; i < nodeQueue.size(); i++) {
         if(*nodeQueue[i] == NOT_EVALUATED) {
-            nodeQueue[i]->solveNode();
+            dumpModel(nodeQueue[i]->getProblem(), "node_" + std::to_string(solvedNodes));
+            solveNode(nodeQueue[i], solvedNodes);
+            metrics.lp_iterations += nodeQueue[i]->getProblem().getLpIterations();
             solvedNodes++;
         }
     }
 }
 
+void BaBTree::recordNewNode(BaBNode* node, BaBNode* parent, NodeDirection direction) {
+    if(!recordNodes) return;
+
+    node->setId(nodeRecords.size());
+    nodeRecords.push_back(NodeLog::newRecord(nodeRecords.size(), (parent == NULL) ? NODE_LOG_NO_PARENT : parent->getId(), node->getDepth(), direction));
+}
+
+void BaBTree::recordSolvedNode(BaBNode* node, double solveTime) {
+    if(!recordNodes) return;
+
+    NodeRecord& record = nodeRecords[node->getId()];
+    record.lpIterations = node->getProblem().getLpIterations();
+    record.solveTime = solveTime;
+    record.fate = NODE_OPEN;
+    if(*node == CONTINUOUS_SOLUTION || *node == WHOLE_SOLUTION) {
+        record.bound = node->getObjectiveFunctionValue() + postsolveStack->getObjectiveOffset();
+
+        Matrix solution = node->getProblem().getOptimalSolution();
+        for(uint j = 0; j < solution.getNColumns(); j++) {
+            if(!isNumberAnInteger(solution.getElement(0, j))) record.fractionalCount++;
+        }
+    }
+}
+
+void BaBTree::recordFate(BaBNode* node, NodeFate fate) {
+    if(recordNodes) nodeRecords[node->getId()].fate = fate;
+}
+
+void BaBTree::solveNode(BaBNode* node, uint number) {
+    switchPhase(NODE_LP_PHASE);
+    // the clock is only read when nodes are recorded
+    std::chrono::steady_clock::time_point start;
+    if(recordNodes) start = std::chrono::steady_clock::now();
+    {
+        TRACE_SCOPE("node", "node", "number", number, "depth", node->getDepth());
+        node->solveNode();
+    }
+    if(recordNodes) recordSolvedNode(node, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    switchPhase(TREE_SEARCH_PHASE);
+}
+
+void BaBTree::branchNode(BaBNode* node, BranchingStrategy branchingStrat, std::vector<BaBNode*>& nodeQueue) {
+    std::pair<uint, double> branchVarInfo = node->getBranchVariableInfo(branchingStrat);
+    TRACE_INSTANT("branch", "search", "variable", branchVarInfo.first, "value", branchVarInfo.second);
+
+    nodeQueue.push_back(node->branchLeft(branchVarInfo.first, branchVarInfo.second));
+    recordNewNode(nodeQueue.back(), node, NODE_LEFT);
+    nodeQueue.push_back(node->branchRight(branchVarInfo.first, branchVarInfo.second));
+    recordNewNode(nodeQueue.back(), node, NODE_RIGHT);
+
+    if(recordNodes) {
+        NodeRecord& record = nodeRecords[node->getId()];
+        record.fate = NODE_BRANCHED;
+        record.branchVariable = branchVarInfo.first;
+        record.branchValue = branchVarInfo.second;
+    }
+}
+
+void BaBTree::publishProgress(const std::vector<BaBNode*>& nodeQueue, BaBNode* incumbentSolution, BaBNode* lastBranched, uint solvedNodes) {
+    double offset = postsolveStack->getObjectiveOffset();
+    bool maximize = originalProblem.getType() == MAX;
+
+    ProgressSnapshot snapshot;
+    snapshot.exploredNodes = solvedNodes;
+    snapshot.openNodes = nodeQueue.size();
+    snapshot.lpIterations = metrics.lp_iterations;
+    snapshot.incumbent = (incumbentSolution == NULL) ? NAN : incumbentSolution->getObjectiveFunctionValue() + offset;
+
+    snapshot.bound = NAN;
+    for(BaBNode* node : nodeQueue) {
+        BaBNode* boundingNode = (*node == NOT_EVALUATED) ? lastBranched : node;
+        if(boundingNode == NULL || (*boundingNode != CONTINUOUS_SOLUTION && *boundingNode != WHOLE_SOLUTION)) continue;
+
+        double value = boundingNode->getObjectiveFunctionValue() + offset;
+        if(std::isnan(snapshot.bound) || (maximize ? value > snapshot.bound : value < snapshot.bound)) snapshot.bound = value;
+    }
+    // nothing is left to explore, the incumbent is optimal
+    if(nodeQueue.empty()) snapshot.bound = snapshot.incumbent;
+
+    progressReporter->publish(snapshot);
+}
+
 void BaBTree::sortNodeQueue(std::vector<BaBNode*>& nodeQueue, ExplorationStrategy strategy) {
     if(strategy == ExplorationStrategy::BEST_VALUE) {
         std::sort(nodeQueue.begin(), nodeQueue.end(), [](BaBNode*& node1, BaBNode*& node2) {
@@ -69,10 +190,208 @@ void BaBTree::sortNodeQueue(std::vector<BaBNode*>& nodeQueue, ExplorationStrateg
     }
 }
 
+void BaBTree::switchPhase(SolvePhase phase) {
+    if(perfCounters == NULL && allocationCounter == NULL) return;
+
+    if(currentPhase != N_SOLVE_PHASES) {
+        if(perfCounters != NULL) addPerfCounts(metrics.phase_counters[currentPhase], perfCounters->stop());
+        if(allocationCounter != NULL) addAllocationStats(metrics.phase_allocations[currentPhase], allocationCounter->stop());
+    }
+    currentPhase = phase;
+    if(currentPhase != N_SOLVE_PHASES) {
+        if(perfCounters != NULL) perfCounters->start();
+        if(allocationCounter != NULL) allocationCounter->start();
+    }
+}
+
+void BaBTree::presolveRoot() {
+    Presolver presolver(originalProblem);
+    rootStatus = presolver.presolve();
+    postsolveStack = std::make_shared<PostsolveStack>(presolver.getPostsolveStack());
+
+    if(rootStatus == NOT_YET_SOLVED && postsolveStack->getNReducedColumns() > 0) {
+        LpProblem reducedProblem = presolver.getReducedProblem();
+        reducedProblem.setScaling(scaling);
+        reducedProblem.setAlgorithm(rootAlgorithm, crossover);
+        headNode = new BaBNode(reducedProblem, 0);
+        dumpModel(reducedProblem, "presolved");
+    }
+}
+
+void BaBTree::solveRootConcurrently() {
+    std::vector<LpAlgorithm> algorithms = {SIMPLEX, BARRIER};
+    std::vector<LpProblem> problems(algorithms.size(), headNode->getProblem());
+    std::atomic<bool> cancelled(false);
+    std::atomic<int> winner(-1);
+
+    std::vector<std::thread> threads;
+    for(uint i = 0; i < algorithms.size(); i++) {
+        problems[i].setAlgorithm(algorithms[i], crossover);
+        problems[i].setCancelFlag(&cancelled);
+        threads.push_back(std::thread([&problems, &cancelled, &winner, &algorithms, i]() {
+            TRACE_THREAD_NAME("root " + convertLpAlgorithmToString(algorithms[i]));
+            TRACE_SCOPE("root LP", "lp");
+            problems[i].solveProblem();
+
+            // only the first algorithm to finish stops the others
+            int expected = -1;
+            if(winner.compare_exchange_strong(expected, (int)i)) cancelled = true;
+        }));
+    }
+    for(std::thread& thread : threads) thread.join();
+
+    LpProblem& winnerProblem = problems[winner];
+    winnerProblem.setCancelFlag(NULL);
+    headNode->getProblem() = winnerProblem;
+    *headNode = EVALUATED;
+
+    metrics.root_algorithm = algorithms[winner];
+}
+
+std::string BaBTree::getResultKey(ExplorationStrategy explorationStrat, BranchingStrategy branchingStrat) {
+    std::ostringstream key;
+    key << std::hex << modelFingerprint.key << std::dec << "-v" << ResultCache::getSolverVersion();
+    key << "-e" << (int)explorationStrat << "-b" << (int)branchingStrat << "-s" << scaling << "-a" << rootAlgorithm << "-c" << crossover << "-r" << concurrentRoot;
+    return key.str();
+}
+
+Matrix BaBTree::getOriginalSolution(BaBNode* node) {
+    std::vector<double> solution = postsolveStack->postsolve(node->getProblem().getOptimalSolution().getElements());
+    for(double& value : solution) value = isDoubleAnInteger(value, 1e-6).second;
+    return Matrix(solution, 1, solution.size());
+}
+
+Matrix BaBTree::finishSearch(BaBNode* incumbentSolution, uint solvedNodes, std::chrono::steady_clock::time_point start) {
+    switchPhase(N_SOLVE_PHASES);
+    perfCounters = NULL;
+    if(allocationCounter != NULL) metrics.peak_resident_memory = getPeakMemory();
+    allocationCounter = NULL;
+
+    metrics.explored_nodes = solvedNodes;
+    metrics.optimalSolutionDepth = 0;
+
+    if(rootStatus == INFEASIBLE || rootStatus == UNBOUNDED) {
+        treeStatus = rootStatus;
+        metrics.optimalWholeSolution = (rootStatus == INFEASIBLE) ? Matrix({0}, 1, 1) : Matrix({INFINITY}, 1, 1);
+    }
+    else if(headNode == NULL) {
+        // presolve fixed every variable
+        treeStatus = WHOLE_SOLUTION;
+        std::vector<double> solution = postsolveStack->postsolve({});
+        metrics.optimalWholeSolution = Matrix(solution, 1, solution.size());
+    }
+    else if(incumbentSolution == NULL) {
+        treeStatus = (*headNode == UNBOUNDED) ? UNBOUNDED : INFEASIBLE;
+        metrics.optimalWholeSolution = (treeStatus == INFEASIBLE) ? Matrix({0}, 1, 1) : Matrix({INFINITY}, 1, 1);
+    }
+    else {
+        treeStatus = WHOLE_SOLUTION;
+        metrics.optimalWholeSolution = getOriginalSolution(incumbentSolution);
+        metrics.optimalSolutionDepth = incumbentSolution->getDepth();
+    }
+
+    // another tree found a better solution, which was used to fathom this tree's nodes
+    if(sharedIncumbent != NULL && sharedIncumbent->hasIncumbent() && headNode != NULL && *headNode != UNBOUNDED) {
+        double sharedValue = sharedIncumbent->getValue();
+        double ownValue = (incumbentSolution == NULL) ? 0 : incumbentSolution->getObjectiveFunctionValue() + postsolveStack->getObjectiveOffset();
+        bool sharedIsBetter = (originalProblem.getType() == MAX) ? sharedValue > ownValue : sharedValue < ownValue;
+        if(incumbentSolution == NULL || sharedIsBetter) {
+            treeStatus = WHOLE_SOLUTION;
+            metrics.optimalWholeSolution = sharedIncumbent->getSolution();
+            metrics.optimalSolutionDepth = 0;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+    metrics.execution_time = elapsed.count();
+
+    // a tree which shares its incumbent may stop before proving optimality, so its result isn't stored
+    if(resultCache != NULL && sharedIncumbent == NULL) {
+        CachedResult result;
+        result.status = treeStatus;
+        result.bound = (treeStatus == WHOLE_SOLUTION) ? metrics.optimalWholeSolution.dotProduct(originalProblem.getObjectiveFunction()) + originalProblem.getObjectiveOffset() : 0;
+        result.metrics = metrics;
+
+        try {
+            resultCache->store(resultKey, modelFingerprint.check, result);
+        }
+        catch(const std::invalid_argument& e) {
+            std::cerr << "Warning: " << e.what() << std::endl;
+        }
+    }
+
+    return metrics.optimalWholeSolution;
+}
+
+void BaBTree::displayAllocationStats() {
+    std::cout << "Heap allocations:" << std::endl;
+    std::cout << std::left << std::setw(14) << "  Phase" << std::right << std::setw(14) << "allocations" << std::setw(18) << "allocated bytes";
+    std::cout << std::setw(18) << "peak live bytes" << std::endl;
+
+    for(uint i = 0; i < N_SOLVE_PHASES; i++) {
+        const AllocationStats& stats = metrics.phase_allocations[i];
+        if(!stats.available) continue;
+
+        std::cout << std::left << std::setw(14) << "  " + convertSolvePhaseToString((SolvePhase)i) << std::right;
+        std::cout << std::setw(14) << stats.allocations << std::setw(18) << stats.bytes << std::setw(18) << stats.peakLiveBytes << std::endl;
+    }
+    std::cout << std::left;
+
+    if(metrics.peak_resident_memory > 0) std::cout << "Peak resident memory: " << metrics.peak_resident_memory << " KB" << std::endl;
+}
+
+void BaBTree::displayPerfCounters() {
+    std::cout << "Performance counters:" << std::endl;
+    std::cout << std::left << std::setw(14) << "  Phase";
+    for(uint j = 0; j < N_PERF_EVENTS; j++) std::cout << std::right << std::setw(16) << convertPerfEventToString((PerfEvent)j);
+    std::cout << std::setw(8) << "IPC" << std::endl;
+
+    for(uint i = 0; i < N_SOLVE_PHASES; i++) {
+        const PerfCounts& counts = metrics.phase_counters[i];
+        if(!hasPerfCounts(counts)) continue;
+
+        std::cout << std::left << std::setw(14) << "  " + convertSolvePhaseToString((SolvePhase)i) << std::right;
+        for(uint j = 0; j < N_PERF_EVENTS; j++) {
+            if(counts.available[j]) std::cout << std::setw(16) << counts.counts[j];
+            else std::cout << std::setw(16) << "n/a";
+        }
+
+        if(counts.available[PERF_CYCLES] && counts.available[PERF_INSTRUCTIONS] && counts.counts[PERF_CYCLES] > 0) {
+            std::cout << std::setw(8) << std::fixed << std::setprecision(2) << (double)counts.counts[PERF_INSTRUCTIONS] / counts.counts[PERF_CYCLES];
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::setprecision(6);
+        }
+        else std::cout << std::setw(8) << "n/a";
+        std::cout << std::endl;
+    }
+    std::cout << std::left;
+
+    if(!perfCountersError.empty()) std::cout << "  Some events can't be counted(" << perfCountersError << ")" << std::endl;
+}
+
 // PUBLIC METHODS
 
 BaBTree::BaBTree(LpProblem initialProblem) {
-    headNode = new BaBNode(initialProblem, 0);
+    originalProblem = initialProblem;
+    headNode = NULL;
+    rootStatus = NOT_YET_SOLVED;
+    treeStatus = NOT_YET_SOLVED;
+    scaling = true;
+    rootAlgorithm = SIMPLEX;
+    crossover = true;
+    concurrentRoot = false;
+    cachedResult = false;
+    cachedExecutionTime = 0;
+    collectPerfCounters = false;
+    trackAllocations = false;
+    recordNodes = false;
+    currentPhase = N_SOLVE_PHASES;
+    for(uint i = 0; i < N_SOLVE_PHASES; i++) {
+        metrics.phase_counters[i] = emptyPerfCounts();
+        metrics.phase_allocations[i] = emptyAllocationStats();
+    }
+    metrics.peak_resident_memory = 0;
 }
 
 Matrix BaBTree::solveTree(ExplorationStrategy explorationStrat, BranchingStrategy branchingStrat) {
@@ -81,29 +400,91 @@ Matrix BaBTree::solveTree(ExplorationStrategy explorationStrat, BranchingStrateg
     std::vector<BaBNode*> nodeQueue;
     uint solvedNodes = 0;
     BaBNode* incumbentSolution = NULL;
+    metrics.lp_iterations = 0;
+    metrics.root_algorithm = rootAlgorithm;
+    for(uint i = PRESOLVE_PHASE; i < N_SOLVE_PHASES; i++) {
+        metrics.phase_counters[i] = emptyPerfCounts();
+        metrics.phase_allocations[i] = emptyAllocationStats();
+    }
+    metrics.peak_resident_memory = 0;
+
+    nodeRecords.clear();
+
+    cachedResult = false;
+    cachedExecutionTime = 0;
+    if(resultCache != NULL) {
+        modelFingerprint = canonicalModelFingerprint(originalProblem);
+        resultKey = getResultKey(explorationStrat, branchingStrat);
+
+        CachedResult result;
+        if(resultCache->lookup(resultKey, modelFingerprint.check, result)) {
+            cachedResult = true;
+            treeStatus = result.status;
+
+            // the cache doesn't store performance counters nor allocations, nothing was solved
+            PerfCounts parseCounters = metrics.phase_counters[PARSE_PHASE];
+            AllocationStats parseAllocations = metrics.phase_allocations[PARSE_PHASE];
+            metrics = result.metrics;
+            for(uint i = 0; i < N_SOLVE_PHASES; i++) {
+                metrics.phase_counters[i] = emptyPerfCounts();
+                metrics.phase_allocations[i] = emptyAllocationStats();
+            }
+            metrics.phase_counters[PARSE_PHASE] = parseCounters;
+            metrics.phase_allocations[PARSE_PHASE] = parseAllocations;
+            metrics.peak_resident_memory = 0;
 
-    headNode->solveNode();
-    //std::cout << "Solved a node, Z = " << headNode->getObjectiveFunctionValue() <<std::endl;
+            // the execution time is this run's, the lookup
+            cachedExecutionTime = metrics.execution_time;
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            metrics.execution_time = elapsed.count();
+            return metrics.optimalWholeSolution;
+        }
+    }
+
+    if(collectPerfCounters) {
+        perfCounters = std::make_shared<PerfCounters>();
+        perfCountersError = perfCounters->getError();
+        if(!perfCounters->isAvailable()) perfCounters = NULL;
+    }
+    if(trackAllocations) allocationCounter = std::make_shared<AllocationCounter>();
+
+    switchPhase(PRESOLVE_PHASE);
+    {
+        TRACE_SCOPE("presolve", "phase");
+        presolveRoot();
+    }
+    if(headNode == NULL) return finishSearch(incumbentSolution, solvedNodes, start);
+    recordNewNode(headNode, NULL, NODE_ROOT);
+
+    switchPhase(ROOT_LP_PHASE);
+    {
+        TRACE_SCOPE("root LP", "phase");
+        auto rootStart = std::chrono::steady_clock::now();
+        if(concurrentRoot) solveRootConcurrently();
+        else headNode->solveNode();
+        recordSolvedNode(headNode, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rootStart).count());
+    }
+    metrics.lp_iterations += headNode->getProblem().getLpIterations();
+    headNode->getProblem().setAlgorithm(SIMPLEX);
     solvedNodes++;
 
+    switchPhase(TREE_SEARCH_PHASE);
+    TRACE_SCOPE("tree search", "phase");
+
+    BaBNode* lastBranched = NULL;
     if(*headNode == CONTINUOUS_SOLUTION) {
-        std::pair<uint, double> branchVarInfo = headNode->getBranchVariableInfo(branchingStrat);
-        nodeQueue.push_back(headNode->branchLeft(branchVarInfo.first, branchVarInfo.second));
-        nodeQueue.push_back(headNode->branchRight(branchVarInfo.first, branchVarInfo.second));
+        branchNode(headNode, branchingStrat, nodeQueue);
+        lastBranched = headNode;
     }
-    else if(*headNode == WHOLE_SOLUTION) {
-        auto end = std::chrono::steady_clock::now();
-        std::chrono::duration<double, std::milli> elapsed = end - start;
-
-        metrics.execution_time = elapsed.count();
-        metrics.explored_nodes = solvedNodes;
-        metrics.optimalWholeSolution = headNode->getProblem().getOptimalSolution();
-        metrics.optimalSolutionDepth = headNode->getDepth();
-    
-        return headNode->getProblem().getOptimalSolution();
+    else {
+        if(*headNode == WHOLE_SOLUTION) updateIncumbentSolution(headNode, incumbentSolution);
+        recordFate(headNode, (*headNode == WHOLE_SOLUTION) ? NODE_INTEGRAL : (*headNode == UNBOUNDED) ? NODE_UNBOUNDED : NODE_INFEASIBLE);
+        return finishSearch(incumbentSolution, solvedNodes, start);
     }
 
     do {
+        if(sharedIncumbent != NULL && sharedIncumbent->isStopped()) break;
+
         solveNodeQueue(nodeQueue, solvedNodes);
 
         fathomLeafNodes(nodeQueue, explorationStrat, incumbentSolution);
@@ -112,46 +493,61 @@ Matrix BaBTree::solveTree(ExplorationStrategy explorationStrat, BranchingStrateg
         sortNodeQueue(nodeQueue, explorationStrat);
 
         if(*nodeQueue[0] == CONTINUOUS_SOLUTION) {
-            std::pair<uint, double> branchVarInfo = nodeQueue[0]->getBranchVariableInfo(branchingStrat);
-            nodeQueue.push_back(nodeQueue[0]->branchLeft(branchVarInfo.first, branchVarInfo.second));
-            nodeQueue.push_back(nodeQueue[0]->branchRight(branchVarInfo.first, branchVarInfo.second));
+            branchNode(nodeQueue[0], branchingStrat, nodeQueue);
+            lastBranched = nodeQueue[0];
         }
 
         if(nodeQueue.size() != 0) nodeQueue.erase(nodeQueue.begin());
 
-    }while(nodeQueue.size() > 0);
-
-    auto end = std::chrono::steady_clock::now();
-    std::chrono::duration<double, std::milli> elapsed = end - start;
+        if(progressReporter != NULL && progressReporter->isSnapshotRequested()) publishProgress(nodeQueue, incumbentSolution, lastBranched, solvedNodes);
 
-    metrics.execution_time = elapsed.count();
-    metrics.explored_nodes = solvedNodes;
-    metrics.optimalWholeSolution = incumbentSolution->getProblem().getOptimalSolution();
-    metrics.optimalSolutionDepth = incumbentSolution->getDepth();
+    }while(nodeQueue.size() > 0);
 
-    return incumbentSolution->getProblem().getOptimalSolution();
+    return finishSearch(incumbentSolution, solvedNodes, start);
 }
 
 void BaBTree::displayProblem(Matrix optimalWholeSolution) {
-    std::cout << "Explored nodes: " << metrics.explored_nodes << std::endl;
+    if(cachedResult) std::cout << "Result read from the result cache(use --no-cache to solve the model again)" << std::endl;
+    std::string cachedLabel = cachedResult ? "(when the result was cached)" : "";
+    std::cout << "Explored nodes" << cachedLabel << ": " << metrics.explored_nodes << std::endl;
+    std::cout << "LP iterations" << cachedLabel << ": " << metrics.lp_iterations << std::endl;
+    std::cout << "Root LP algorithm: " << convertLpAlgorithmToString(metrics.root_algorithm) << std::endl;
+    if(collectPerfCounters && !cachedResult) displayPerfCounters();
+    if(trackAllocations && !cachedResult) displayAllocationStats();
+    if(treeStatus == INFEASIBLE) {
+        std::cout << "The problem is infeasible" << std::endl;
+        return;
+    }
+    else if(treeStatus == UNBOUNDED) {
+        std::cout << "The problem is unbounded" << std::endl;
+        return;
+    }
+
     std::cout << "The optimal solution is located at depth " << metrics.optimalSolutionDepth << std::endl;
-    std::cout << "Execution time: "; //<< metrics.execution_time << " ms" << std::endl;
-    if(metrics.execution_time > 1000) std::cout << metrics.execution_time / 1000 << " s" << std::endl;
-    else if(metrics.execution_time < 1) std::cout << metrics.execution_time * 1000 << " us" << std::endl;
-    else std::cout << metrics.execution_time << " ms" << std::endl;
+    std::cout << "Execution time: ";
+    displayTime(metrics.execution_time);
+    if(cachedResult) {
+        std::cout << "(result cache lookup, the cached solve took ";
+        displayTime(cachedExecutionTime);
+        std::cout << ")";
+    }
+    std::cout << std::endl;
 
     std::cout << "The optimal solution is: (";
     for(uint i = 0; i < metrics.optimalWholeSolution.getNColumns(); i++) {
         std::cout << metrics.optimalWholeSolution.getElement(0, i);
         if(i < metrics.optimalWholeSolution.getNColumns() - 1) std::cout << ", ";
     }
-    std::cout << "), Z = " << metrics.optimalWholeSolution.dotProduct(headNode->getProblem().getObjectiveFunction()) << std::endl;
+    std::cout << "), Z = " << metrics.optimalWholeSolution.dotProduct(originalProblem.getObjectiveFunction()) + originalProblem.getObjectiveOffset() << std::endl;
 }
 
 void BaBTree::deleteTree() {
+    if(headNode == NULL) return;
+
     headNode->deleteSubNodes();
 
     delete headNode;
+    headNode = NULL;
 }
 
 PerformanceMetrics BaBTree::getMetrics() {
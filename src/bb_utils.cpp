@@ -1,6 +1,7 @@
 #include "bb_utils.h"
 
 #include <cmath>
+#include <stdexcept>
 
 bool isNumberAnInteger(double number, double epsilon) {
     return std::abs(number - std::round(number)) < epsilon;
@@ -63,4 +64,83 @@ std::string convertBranchStratToString(BranchingStrategy strat) {
     }
 
     return returnValue;
+}
+
+std::string convertLpAlgorithmToString(LpAlgorithm algorithm) {
+    std::string returnValue;
+    switch (algorithm)
+    {
+    case SIMPLEX:
+        returnValue = "SIMPLEX";
+        break;
+    case BARRIER:
+        returnValue = "BARRIER";
+        break;
+    }
+
+    return returnValue;
+}
+
+std::string convertProblemStatusToString(ProblemStatus status) {
+    std::string returnValue;
+    switch (status)
+    {
+    case NOT_YET_SOLVED:
+        returnValue = "NOT_YET_SOLVED";
+        break;
+    case CONTINUOUS_SOLUTION:
+        returnValue = "CONTINUOUS_SOLUTION";
+        break;
+    case WHOLE_SOLUTION:
+        returnValue = "WHOLE_SOLUTION";
+        break;
+    case INFEASIBLE:
+        returnValue = "INFEASIBLE";
+        break;
+    case UNBOUNDED:
+        returnValue = "UNBOUNDED";
+        break;
+    }
+
+    return returnValue;
+}
+
+std::string convertSolvePhaseToString(SolvePhase phase) {
+    std::string returnValue;
+    switch (phase)
+    {
+    case PARSE_PHASE:
+        returnValue = "parse";
+        break;
+    case PRESOLVE_PHASE:
+        returnValue = "presolve";
+        break;
+    case ROOT_LP_PHASE:
+        returnValue = "root_lp";
+        break;
+    case NODE_LP_PHASE:
+        returnValue = "node_lp";
+        break;
+    case TREE_SEARCH_PHASE:
+        returnValue = "tree_search";
+        break;
+    default:
+        break;
+    }
+
+    return returnValue;
+}
+
+ExplorationStrategy convertStringToExplorStrat(const std::string& name) {
+    for(ExplorationStrategy strat : getPossibleExplorationStrategies()) {
+        if(convertExplorStratToString(strat) == name) return strat;
+    }
+    throw std::invalid_argument("Invalid exploration strategy: " + name);
+}
+
+BranchingStrategy convertStringToBranchStrat(const std::string& name) {
+    for(BranchingStrategy strat : getPossibleBranchingStrategies()) {
+        if(convertBranchStratToString(strat) == name) return strat;
+    }
+    throw std::invalid_argument("Invalid branching strategy: " + name);
 }
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "binary_model.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+namespace {
+
+template<typename T>
+void appendArray(std::string& payload, const T* data, size_t count) {
+    payload.append((const char*)data, count * sizeof(T));
+}
+
+template<typename T>
+void readArray(std::string_view& payload, std::vector<T>& array, size_t count) {
+    if(payload.size() < count * sizeof(T)) throw std::invalid_argument("Truncated binary model");
+
+    array.resize(count);
+    if(count > 0) std::memcpy(array.data(), payload.data(), count * sizeof(T));
+    payload.remove_prefix(count * sizeof(T));
+}
+
+void appendFlags(std::string& payload, const std::vector<bool>& flags) {
+    for(bool flag : flags) payload.push_back(flag ? 1 : 0);
+}
+
+template<typename T>
+void appendBytes(std::string& payload, const std::vector<T>& values) {
+    for(T value : values) payload.push_back((char)value);
+}
+
+}
+
+// PRIVATE METHODS
+
+uint64_t BinaryModel::hash(std::string_view data) {
+    uint64_t result = 0xcbf29ce484222325ull;
+    size_t i = 0;
+
+    for(; i + 8 <= data.size(); i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data.data() + i, 8);
+        result = (result ^ word) * 0x100000001b3ull;
+        result ^= result >> 29;
+    }
+    for(; i < data.size(); i++) result = (result ^ (unsigned char)data[i]) * 0x100000001b3ull;
+
+    return result;
+}
+
+BinaryModelHeader BinaryModel::readHeader(std::string_view contents) {
+    BinaryModelHeader header;
+    if(contents.size() < sizeof(header)) throw std::invalid_argument("Invalid binary model: the file is too small");
+
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if(std::memcmp(header.magic, BINARY_MODEL_MAGIC, sizeof(header.magic)) != 0) throw std::invalid_argument("Invalid binary model: wrong magic number");
+    if(header.version != BINARY_MODEL_VERSION) {
+        std::ostringstream errorMsg;
+        errorMsg << "Unsupported binary model version " << header.version << "(expected " << BINARY_MODEL_VERSION << ")";
+        throw std::invalid_argument(errorMsg.str());
+    }
+    if(contents.size() - sizeof(header) != header.payloadSize) throw std::invalid_argument("Invalid binary model: truncated payload");
+
+    return header;
+}
+
+// PUBLIC METHODS
+
+ModelSourceStamp BinaryModel::getSourceStamp(const std::string& fileName) {
+    std::error_code error;
+    ModelSourceStamp stamp;
+    stamp.size = std::filesystem::file_size(fileName, error);
+    if(error) throw std::invalid_argument("Cannot read the size of " + fileName);
+
+    stamp.modified = std::filesystem::last_write_time(fileName, error).time_since_epoch().count();
+    if(error) throw std::invalid_argument("Cannot read the modification time of " + fileName);
+
+    return stamp;
+}
+
+void BinaryModel::write(const SparseModel& model, const std::string& fileName, ModelSourceStamp source) {
+    uint nRows = model.rowTypes.size(), nColumns = model.objective.size();
+
+    std::string payload;
+    payload.reserve((3 * nColumns + 2 * nRows + model.values.size()) * sizeof(double) + (nColumns + 1 + model.rowIndex.size()) * sizeof(uint32_t));
+
+    appendArray(payload, model.objective.data(), nColumns);
+    appendArray(payload, model.lowerBounds.data(), nColumns);
+    appendArray(payload, model.upperBounds.data(), nColumns);
+    appendArray(payload, model.rhs.data(), nRows);
+    appendArray(payload, model.ranges.data(), nRows);
+    appendArray(payload, model.values.data(), model.values.size());
+    appendArray(payload, model.columnStart.data(), nColumns + 1);
+    appendArray(payload, model.rowIndex.data(), model.rowIndex.size());
+    appendBytes(payload, model.rowTypes);
+    appendFlags(payload, model.integer);
+
+    std::vector<uint32_t> nameLengths = {(uint32_t)model.name.size()};
+    for(const std::string& name : model.rowNames) nameLengths.push_back(name.size());
+    for(const std::string& name : model.columnNames) nameLengths.push_back(name.size());
+    appendArray(payload, nameLengths.data(), nameLengths.size());
+    payload += model.name;
+    for(const std::string& name : model.rowNames) payload += name;
+    for(const std::string& name : model.columnNames) payload += name;
+
+    BinaryModelHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_MODEL_MAGIC, sizeof(header.magic));
+    header.version = BINARY_MODEL_VERSION;
+    header.type = model.type;
+    header.source = source;
+    header.contentHash = hash(payload);
+    header.payloadSize = payload.size();
+    header.nRows = nRows;
+    header.nColumns = nColumns;
+    header.nNonzeros = model.values.size();
+    header.objectiveOffset = model.objectiveOffset;
+
+    std::string temporaryName = fileName + ".tmp";
+    {
+        std::ofstream file(temporaryName, std::ios::binary | std::ios::trunc);
+        if(!file) throw std::invalid_argument("Cannot create binary model " + temporaryName);
+
+        file.write((const char*)&header, sizeof(header));
+        file.write(payload.data(), payload.size());
+        if(!file) throw std::invalid_argument("Cannot write binary model " + temporaryName);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryName, fileName, error);
+    if(error) throw std::invalid_argument("Cannot rename " + temporaryName + " to " + fileName);
+}
+
+bool BinaryModel::isUpToDate(std::string_view contents, ModelSourceStamp source) {
+    try {
+        BinaryModelHeader header = readHeader(contents);
+        return header.source.size == source.size && header.source.modified == source.modified;
+    }
+    catch(const std::invalid_argument& e) {
+        return false;
+    }
+}
+
+SparseModel BinaryModel::read(std::string_view contents) {
+    BinaryModelHeader header = readHeader(contents);
+    std::string_view payload = contents.substr(sizeof(header));
+    if(hash(payload) != header.contentHash) throw std::invalid_argument("Invalid binary model: the content hash doesn't match");
+
+    uint nRows = header.nRows, nColumns = header.nColumns;
+    SparseModel model = emptySparseModel();
+    model.type = (ProblemType)header.type;
+    model.objectiveOffset = header.objectiveOffset;
+
+    readArray(payload, model.objective, nColumns);
+    readArray(payload, model.lowerBounds, nColumns);
+    readArray(payload, model.upperBounds, nColumns);
+    readArray(payload, model.rhs, nRows);
+    readArray(payload, model.ranges, nRows);
+    readArray(payload, model.values, header.nNonzeros);
+    readArray(payload, model.columnStart, nColumns + 1);
+    readArray(payload, model.rowIndex, header.nNonzeros);
+
+    std::vector<uint8_t> bytes;
+    readArray(payload, bytes, nRows);
+    model.rowTypes.resize(nRows);
+    for(uint i = 0; i < nRows; i++) {
+        if(bytes[i] > GREATER_THAN_OR_EQUAL) throw std::invalid_argument("Invalid binary model: unknown row type");
+        model.rowTypes[i] = (ConstraintType)bytes[i];
+    }
+
+    readArray(payload, bytes, nColumns);
+    model.integer.resize(nColumns);
+    for(uint j = 0; j < nColumns; j++) model.integer[j] = bytes[j] != 0;
+
+    // the matrix indexes are trusted by the rest of the solver, so they're checked once here
+    if(model.columnStart[0] != 0 || model.columnStart[nColumns] != header.nNonzeros) throw std::invalid_argument("Invalid binary model: inconsistent column starts");
+    for(uint j = 0; j < nColumns; j++) {
+        if(model.columnStart[j] > model.columnStart[j + 1]) throw std::invalid_argument("Invalid binary model: inconsistent column starts");
+    }
+    for(uint row : model.rowIndex) {
+        if(row >= nRows) throw std::invalid_argument("Invalid binary model: row index out of range");
+    }
+
+    std::vector<uint32_t> nameLengths;
+    readArray(payload, nameLengths, 1 + nRows + nColumns);
+    auto readName = [&payload](uint32_t length) {
+        if(payload.size() < length) throw std::invalid_argument("Truncated binary model");
+        std::string name(payload.substr(0, length));
+        payload.remove_prefix(length);
+        return name;
+    };
+
+    model.name = readName(nameLengths[0]);
+    model.rowNames.reserve(nRows);
+    for(uint i = 0; i < nRows; i++) model.rowNames.push_back(readName(nameLengths[1 + i]));
+    model.columnNames.reserve(nColumns);
+    for(uint j = 0; j < nColumns; j++) model.columnNames.push_back(readName(nameLengths[1 + nRows + j]));
+
+    return model;
+}
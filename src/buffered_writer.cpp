@@ -0,0 +1,98 @@
+#include "buffered_writer.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+// PRIVATE METHODS
+
+void BufferedWriter::writeAll(const char* data, size_t size) {
+    size_t written = 0;
+    while(written < size) {
+        ssize_t result = write(fileDescriptor, data + written, size - written);
+        if(result < 0) {
+            if(errno == EINTR) continue;
+            throw std::invalid_argument("Cannot write to " + fileName + ": " + std::strerror(errno));
+        }
+        written += result;
+    }
+}
+
+void BufferedWriter::flush() {
+    writeAll(buffer, used);
+    used = 0;
+}
+
+// PUBLIC METHODS
+
+BufferedWriter::BufferedWriter(const std::string& newFileName) {
+    fileName = newFileName;
+    used = 0;
+
+    fileDescriptor = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fileDescriptor < 0) throw std::invalid_argument("Cannot create " + fileName + ": " + std::strerror(errno));
+}
+
+BufferedWriter::~BufferedWriter() {
+    try {
+        close();
+    }
+    catch(const std::invalid_argument& e) {
+    }
+}
+
+void BufferedWriter::close() {
+    if(fileDescriptor < 0) return;
+
+    // the file is closed even if the last write fails
+    int descriptor = fileDescriptor;
+    try {
+        flush();
+    }
+    catch(const std::invalid_argument& e) {
+        fileDescriptor = -1;
+        ::close(descriptor);
+        throw;
+    }
+
+    fileDescriptor = -1;
+    if(::close(descriptor) != 0) throw std::invalid_argument("Cannot close " + fileName + ": " + std::strerror(errno));
+}
+
+BufferedWriter& BufferedWriter::operator<<(std::string_view text) {
+    // text bigger than the buffer is written directly
+    if(text.size() >= WRITE_BUFFER_SIZE) {
+        flush();
+        writeAll(text.data(), text.size());
+        return *this;
+    }
+
+    if(used + text.size() > WRITE_BUFFER_SIZE) flush();
+    std::memcpy(buffer + used, text.data(), text.size());
+    used += text.size();
+    return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(char character) {
+    if(used == WRITE_BUFFER_SIZE) flush();
+    buffer[used++] = character;
+    return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(uint value) {
+    char digits[16];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    return *this << std::string_view(digits, result.ptr - digits);
+}
+
+BufferedWriter& BufferedWriter::operator<<(double value) {
+    if(std::isinf(value)) return *this << (value > 0 ? std::string_view("1e30") : std::string_view("-1e30"));
+
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    return *this << std::string_view(digits, result.ptr - digits);
+}
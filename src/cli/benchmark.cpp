@@ -3,6 +3,133 @@
 #include "lp.h"
 #include "model_reader.h"
 #include "bb_tree.h"
+#include "scaling.h"
+#include "memory_usage.h"
+#include "buffered_writer.h"
+#include "json_reader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <map>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+namespace {
+
+// the samples of each metric recorded by a benchmark suite, with the name they're reported under
+std::vector<std::pair<std::string, const std::vector<double>*>> getSampleSets(const BenchmarkModelResult& result) {
+    std::vector<std::pair<std::string, const std::vector<double>*>> sampleSets = {
+        {"time_ms", &result.times},
+        {"explored_nodes", &result.exploredNodes},
+        {"lp_iterations", &result.lpIterations},
+        {"peak_memory_kb", &result.peakMemory}
+    };
+    for(const std::pair<std::string, std::vector<double>>& phaseSample : result.phaseSamples) sampleSets.push_back({phaseSample.first, &phaseSample.second});
+    return sampleSets;
+}
+
+// adds `sample` to the samples of `result` named `phase`_`metric`
+void addPhaseSample(BenchmarkModelResult& result, SolvePhase phase, const std::string& metric, double sample) {
+    std::string name = convertSolvePhaseToString(phase) + "_" + metric;
+    auto samples = std::find_if(result.phaseSamples.begin(), result.phaseSamples.end(), [&name](const std::pair<std::string, std::vector<double>>& s) { return s.first == name; });
+    if(samples == result.phaseSamples.end()) {
+        result.phaseSamples.push_back({name, {}});
+        samples = result.phaseSamples.end() - 1;
+    }
+    samples->second.push_back(sample);
+}
+
+// adds the available events of `counts` and the allocations `allocations`(if available), measured during `phase`, to the samples of `result`
+void addPhaseSamples(BenchmarkModelResult& result, SolvePhase phase, const PerfCounts& counts, const AllocationStats& allocations) {
+    for(uint j = 0; j < N_PERF_EVENTS; j++) {
+        if(counts.available[j]) addPhaseSample(result, phase, convertPerfEventToString((PerfEvent)j), counts.counts[j]);
+    }
+
+    if(!allocations.available) return;
+    addPhaseSample(result, phase, "allocations", allocations.allocations);
+    addPhaseSample(result, phase, "allocated_bytes", allocations.bytes);
+    addPhaseSample(result, phase, "peak_live_bytes", allocations.peakLiveBytes);
+}
+
+// `text` as a JSON string, with quotes, backslashes and control characters escaped
+std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for(char character : text) {
+        if(character == '"' || character == '\\') {
+            escaped += '\\';
+            escaped += character;
+        }
+        else if((unsigned char)character < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", character);
+            escaped += code;
+        }
+        else escaped += character;
+    }
+    return escaped + '"';
+}
+
+// `text` as a CSV field, quoted only if it has to be
+std::string csvField(const std::string& text) {
+    if(text.find_first_of(",\"\n") == std::string::npos) return text;
+
+    std::string quoted = "\"";
+    for(char character : text) {
+        if(character == '"') quoted += '"';
+        quoted += character;
+    }
+    return quoted + '"';
+}
+
+bool isModelFileName(std::string fileName) {
+    for(std::string compressed : {".gz", ".zst"}) {
+        if(fileName.size() > compressed.size() && fileName.compare(fileName.size() - compressed.size(), compressed.size(), compressed) == 0) {
+            fileName.resize(fileName.size() - compressed.size());
+        }
+    }
+
+    std::string extension = std::filesystem::path(fileName).extension().string();
+    return extension == ".lp" || extension == ".mps";
+}
+
+std::string formatTime(double milliseconds) {
+    if(milliseconds > 1000) return std::to_string(milliseconds / 1000) + " s";
+    if(milliseconds < 1) return std::to_string(milliseconds * 1000) + " us";
+    return std::to_string(milliseconds) + " ms";
+}
+
+std::vector<double> readJsonSamples(const JsonValue& metrics, const std::string& name) {
+    std::vector<double> samples;
+    for(const JsonValue& sample : getJsonMember(getJsonMember(metrics, name, JsonType::OBJECT), "samples", JsonType::ARRAY).items) {
+        if(sample.type != JsonType::NUMBER) throw std::invalid_argument("Benchmark report sample isn't a number: " + name);
+        samples.push_back(sample.number);
+    }
+    return samples;
+}
+
+// p-value of the difference between two sets of samples. Samples which never vary(e.g. the explored nodes of deterministic strategies)
+// differ for sure as soon as they aren't equal, however few there are
+double getChangePValue(const std::vector<double>& baseline, const std::vector<double>& current) {
+    SampleStatistics baselineStatistics = computeStatistics(baseline), currentStatistics = computeStatistics(current);
+    if(baselineStatistics.min == baselineStatistics.p99 && currentStatistics.min == currentStatistics.p99) {
+        return baselineStatistics.median == currentStatistics.median ? 1 : 0;
+    }
+    return mannWhitneyPValue(baseline, current);
+}
+
+}
 
 // PRIVATE METHODS
 
@@ -10,12 +137,12 @@ void Benchmark::displayBenchmarkResults(uint metricsIndex) {
     tabulate::Table results;
 
     // sort the metrics by ascending order of average execution time
-    std::sort(metrics.things.begin(), metrics.things.end(), [](const std::tuple<double, std::pair<ExplorationStrategy, BranchingStrategy>, uint>& a,
-                                                               const std::tuple<double, std::pair<ExplorationStrategy, BranchingStrategy>, uint>& b) {
+    std::sort(metrics.things.begin(), metrics.things.end(), [](const std::tuple<double, std::pair<ExplorationStrategy, BranchingStrategy>, uint, uint>& a,
+                                                               const std::tuple<double, std::pair<ExplorationStrategy, BranchingStrategy>, uint, uint>& b) {
                                                                 return std::get<0>(a) < std::get<0>(b);
                                                                });
 
-    results.add_row({"Exploration strategy", "Branching strategy", "Explored nodes", "Average execution time"});
+    results.add_row({"Exploration strategy", "Branching strategy", "Explored nodes", "LP iterations", "Average execution time"});
 
     for(int i = 0; i < metrics.things.size(); i++) {
         std::string time_str;
@@ -26,12 +153,540 @@ void Benchmark::displayBenchmarkResults(uint metricsIndex) {
         std::string currentExplorStratString = convertExplorStratToString(std::get<1>(metrics.things[i]).first);
         std::string currentBranchStratString = convertBranchStratToString(std::get<1>(metrics.things[i]).second);
         std::string currentExploredNodesString = std::to_string(std::get<2>(metrics.things[i]));
-        results.add_row({currentExplorStratString, currentBranchStratString, currentExploredNodesString, time_str});
+        std::string currentLpIterationsString = std::to_string(std::get<3>(metrics.things[i]));
+        results.add_row({currentExplorStratString, currentBranchStratString, currentExploredNodesString, currentLpIterationsString, time_str});
     }
 
     std::cout << results << std::endl;
 }
 
+void Benchmark::displayScalingResults(LpProblem& benchmarkProblem) {
+    tabulate::Table results;
+    results.add_row({"Scaling", "Coefficient ratio", "Root LP iterations"});
+
+    for(bool scaling : {false, true}) {
+        LpProblem rootProblem = benchmarkProblem;
+        rootProblem.setScaling(scaling);
+        rootProblem.solveProblem();
+
+        double quality = scaling ? rootProblem.getScalingQuality().second : scalingQuality(rootProblem);
+        results.add_row({scaling ? "on" : "off", std::to_string(quality), std::to_string(rootProblem.getLpIterations())});
+    }
+
+    std::cout << results << std::endl;
+}
+
+std::vector<std::string> Benchmark::getSuiteModels(const std::string& path) {
+    std::vector<std::string> models;
+
+    if(std::filesystem::is_directory(path)) {
+        for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path)) {
+            if(entry.is_regular_file() && isModelFileName(entry.path().filename().string())) models.push_back(entry.path().string());
+        }
+        std::sort(models.begin(), models.end());
+    }
+    else {
+        std::ifstream manifest(path);
+        if(!manifest) throw std::invalid_argument("Benchmark suite does not exist: " + path);
+
+        std::filesystem::path manifestDirectory = std::filesystem::path(path).parent_path();
+        std::string line;
+        while(std::getline(manifest, line)) {
+            size_t start = line.find_first_not_of(" \t\r");
+            if(start == std::string::npos || line[start] == '#') continue;
+            size_t end = line.find_last_not_of(" \t\r");
+            std::filesystem::path model = line.substr(start, end - start + 1);
+
+            models.push_back(model.is_absolute() ? model.string() : (manifestDirectory / model).string());
+        }
+    }
+
+    if(models.empty()) throw std::invalid_argument("Benchmark suite has no models: " + path);
+    return models;
+}
+
+std::string Benchmark::getSuiteModelName(const std::string& path, const std::string& model) {
+    std::filesystem::path suiteDirectory = std::filesystem::is_directory(path) ? std::filesystem::path(path) : std::filesystem::path(path).parent_path();
+    std::filesystem::path relative = std::filesystem::path(model).lexically_relative(suiteDirectory);
+
+    if(relative.empty() || *relative.begin() == "..") return std::filesystem::path(model).filename().string();
+    return relative.generic_string();
+}
+
+std::vector<BenchmarkModelResult> Benchmark::benchmarkModels(std::vector<LpProblem>& problems, const std::vector<std::string>& names, const BenchmarkSuiteOptions& options,
+                                                             const std::vector<PerfCounts>& parseCounts, const std::vector<AllocationStats>& parseAllocations) {
+    // every run is a cell which solves its own copy of its model, the warmup runs of a model coming before its measured runs
+    std::vector<BenchmarkCell> cells;
+    for(uint i = 0; i < problems.size(); i++) {
+        for(uint k = 0; k < options.warmupRuns + options.measuredRuns; k++) {
+            cells.push_back({&problems[i], options.explorationStrat, options.branchingStrat, i, k >= options.warmupRuns, options.perfCounters, options.allocationStats});
+        }
+    }
+    std::vector<BenchmarkRun> runs = executeCells(cells, options.parallelism, names);
+
+    std::vector<BenchmarkModelResult> results;
+    for(uint i = 0; i < problems.size(); i++) {
+        BenchmarkModelResult result;
+        result.fileName = names[i];
+        result.modelName = names[i];
+        result.nRows = problems[i].getConstraints().size();
+        result.nColumns = problems[i].getObjectiveFunction().getNColumns();
+        result.explorationStrat = options.explorationStrat;
+        result.branchingStrat = options.branchingStrat;
+        result.status = NOT_YET_SOLVED;
+        result.objective = 0;
+        // the models are only parsed once, so the parse phase has a single sample
+        if(i < parseCounts.size()) addPhaseSamples(result, PARSE_PHASE, parseCounts[i], parseAllocations[i]);
+        results.push_back(result);
+    }
+
+    for(uint c = 0; c < cells.size(); c++) {
+        if(!cells[c].measured) continue;
+
+        BenchmarkModelResult& result = results[cells[c].group];
+        result.times.push_back(runs[c].time);
+        result.exploredNodes.push_back(runs[c].exploredNodes);
+        result.lpIterations.push_back(runs[c].lpIterations);
+        result.peakMemory.push_back(runs[c].peakMemory);
+        result.status = runs[c].status;
+        result.objective = runs[c].objective;
+        for(uint phase = 0; phase < N_SOLVE_PHASES; phase++) addPhaseSamples(result, (SolvePhase)phase, runs[c].phaseCounters[phase], runs[c].phaseAllocations[phase]);
+    }
+
+    return results;
+}
+
+void Benchmark::displaySuiteResults(const std::vector<BenchmarkModelResult>& results) {
+    tabulate::Table table;
+    table.add_row({"Model", "Status", "Min time", "Median time", "p90 time", "p99 time", "Time stddev", "Median nodes", "Median LP iterations", "Median peak memory"});
+
+    for(const BenchmarkModelResult& result : results) {
+        SampleStatistics times = computeStatistics(result.times);
+        table.add_row({std::filesystem::path(result.fileName).filename().string(), convertProblemStatusToString(result.status),
+                       formatTime(times.min), formatTime(times.median), formatTime(times.p90), formatTime(times.p99), formatTime(times.stddev),
+                       std::to_string((uint)computeStatistics(result.exploredNodes).median),
+                       std::to_string((uint)computeStatistics(result.lpIterations).median),
+                       std::to_string(computeStatistics(result.peakMemory).median / 1024) + " MB"});
+    }
+
+    std::cout << table << std::endl;
+}
+
+void Benchmark::writeSuiteJson(const std::vector<BenchmarkModelResult>& results, const BenchmarkSuiteOptions& options) {
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    BufferedWriter writer(options.jsonFile);
+    writer << "{\n  \"version\": " << (uint)BENCHMARK_REPORT_VERSION << ",\n";
+    writer << "  \"timestamp\": " << jsonString(timestamp) << ",\n";
+    writer << "  \"exploration_strategy\": " << jsonString(convertExplorStratToString(options.explorationStrat)) << ",\n";
+    writer << "  \"branching_strategy\": " << jsonString(convertBranchStratToString(options.branchingStrat)) << ",\n";
+    writer << "  \"warmup_runs\": " << options.warmupRuns << ",\n";
+    writer << "  \"measured_runs\": " << options.measuredRuns << ",\n";
+    writer << "  \"models\": [";
+
+    for(uint i = 0; i < results.size(); i++) {
+        writer << (i == 0 ? "\n" : ",\n") << "    {\n";
+        writer << "      \"file\": " << jsonString(results[i].fileName) << ",\n";
+        writer << "      \"model\": " << jsonString(results[i].modelName) << ",\n";
+        writer << "      \"exploration_strategy\": " << jsonString(convertExplorStratToString(results[i].explorationStrat)) << ",\n";
+        writer << "      \"branching_strategy\": " << jsonString(convertBranchStratToString(results[i].branchingStrat)) << ",\n";
+        writer << "      \"rows\": " << results[i].nRows << ",\n";
+        writer << "      \"columns\": " << results[i].nColumns << ",\n";
+        writer << "      \"status\": " << jsonString(convertProblemStatusToString(results[i].status)) << ",\n";
+        writer << "      \"objective\": " << results[i].objective << ",\n";
+        writer << "      \"metrics\": {";
+
+        std::vector<std::pair<std::string, const std::vector<double>*>> sampleSets = getSampleSets(results[i]);
+        for(uint j = 0; j < sampleSets.size(); j++) {
+            const std::vector<double>& samples = *sampleSets[j].second;
+            SampleStatistics statistics = computeStatistics(samples);
+
+            writer << (j == 0 ? "\n" : ",\n") << "        " << jsonString(sampleSets[j].first) << ": {";
+            writer << "\"min\": " << statistics.min << ", \"median\": " << statistics.median << ", \"p90\": " << statistics.p90;
+            writer << ", \"p99\": " << statistics.p99 << ", \"mean\": " << statistics.mean << ", \"stddev\": " << statistics.stddev;
+            writer << ", \"samples\": [";
+            for(uint k = 0; k < samples.size(); k++) {
+                if(k > 0) writer << ", ";
+                writer << samples[k];
+            }
+            writer << "]}";
+        }
+        writer << "\n      }\n    }";
+    }
+
+    writer << "\n  ]\n}\n";
+    writer.close();
+}
+
+void Benchmark::writeSuiteCsv(const std::vector<BenchmarkModelResult>& results, const BenchmarkSuiteOptions& options) {
+    BufferedWriter writer(options.csvFile);
+    writer << "model,rows,columns,status,metric,runs,min,median,p90,p99,mean,stddev\n";
+
+    for(const BenchmarkModelResult& result : results) {
+        for(const std::pair<std::string, const std::vector<double>*>& sampleSet : getSampleSets(result)) {
+            SampleStatistics statistics = computeStatistics(*sampleSet.second);
+            writer << csvField(result.fileName) << ',' << result.nRows << ',' << result.nColumns << ',' << convertProblemStatusToString(result.status) << ',' << sampleSet.first << ',';
+            writer << (uint)sampleSet.second->size() << ',' << statistics.min << ',' << statistics.median << ',' << statistics.p90 << ',';
+            writer << statistics.p99 << ',' << statistics.mean << ',' << statistics.stddev << '\n';
+        }
+    }
+
+    writer.close();
+}
+
+void Benchmark::displaySweepResults(const std::vector<BenchmarkModelResult>& results, const std::vector<uint>& sizes) {
+    const uint barWidth = 40;
+
+    std::vector<double> times, nodes;
+    for(const BenchmarkModelResult& result : results) {
+        times.push_back(std::max(computeStatistics(result.times).median, 1e-6));
+        nodes.push_back(computeStatistics(result.exploredNodes).median);
+    }
+    double minTime = *std::min_element(times.begin(), times.end()), maxTime = *std::max_element(times.begin(), times.end());
+
+    tabulate::Table table;
+    table.add_row({"Size", "Rows", "Columns", "Median time", "Time growth", "Median nodes", "Node growth", "Time(log scale)"});
+
+    for(uint i = 0; i < results.size(); i++) {
+        // local exponent k of time ~ size^k between this size and the previous one, which shoots up where the solver breaks down
+        std::string timeGrowth = "-", nodeGrowth = "-";
+        if(i > 0 && sizes[i] != sizes[i - 1]) {
+            double sizeRatio = std::log((double)sizes[i] / sizes[i - 1]);
+            std::ostringstream timeText, nodeText;
+            timeText << std::fixed << std::setprecision(2) << std::log(times[i] / times[i - 1]) / sizeRatio;
+            timeGrowth = timeText.str();
+            if(nodes[i] > 0 && nodes[i - 1] > 0) {
+                nodeText << std::fixed << std::setprecision(2) << std::log(nodes[i] / nodes[i - 1]) / sizeRatio;
+                nodeGrowth = nodeText.str();
+            }
+        }
+
+        uint bar = 1;
+        if(maxTime > minTime) bar += std::round((barWidth - 1) * std::log(times[i] / minTime) / std::log(maxTime / minTime));
+
+        table.add_row({std::to_string(sizes[i]), std::to_string(results[i].nRows), std::to_string(results[i].nColumns), formatTime(times[i]), timeGrowth,
+                       std::to_string((uint)nodes[i]), nodeGrowth, std::string(bar, '#')});
+    }
+
+    std::cout << table << std::endl;
+}
+
+bool Benchmark::reportSuiteResults(const std::vector<BenchmarkModelResult>& results, const std::vector<BenchmarkModelResult>& baseline, const BenchmarkSuiteOptions& options) {
+    if(!options.jsonFile.empty()) writeSuiteJson(results, options);
+    if(!options.csvFile.empty()) writeSuiteCsv(results, options);
+
+    if(options.baselineFile.empty()) return true;
+    return compareSuiteResults(baseline, results, options.regressionThreshold);
+}
+
+std::vector<BenchmarkModelResult> Benchmark::readSuiteJson(const std::string& fileName) {
+    JsonValue report = JsonReader::parseFile(fileName);
+    if(getJsonMember(report, "version", JsonType::NUMBER).number != BENCHMARK_REPORT_VERSION) {
+        throw std::invalid_argument("Benchmark report was written by another version: " + fileName);
+    }
+
+    std::vector<BenchmarkModelResult> results;
+    for(const JsonValue& model : getJsonMember(report, "models", JsonType::ARRAY).items) {
+        BenchmarkModelResult result;
+        result.fileName = getJsonMember(model, "file", JsonType::STRING).text;
+        // reports written before models were named relative to their suite have no name, and are matched by file name
+        std::vector<std::pair<std::string, JsonValue>>::const_iterator modelName = std::find_if(model.members.begin(), model.members.end(),
+            [](const std::pair<std::string, JsonValue>& member) { return member.first == "model" && member.second.type == JsonType::STRING; });
+        result.modelName = (modelName != model.members.end()) ? modelName->second.text : "";
+        result.nRows = 0;
+        result.nColumns = 0;
+        result.explorationStrat = convertStringToExplorStrat(getJsonMember(model, "exploration_strategy", JsonType::STRING).text);
+        result.branchingStrat = convertStringToBranchStrat(getJsonMember(model, "branching_strategy", JsonType::STRING).text);
+        result.status = NOT_YET_SOLVED;
+        result.objective = getJsonMember(model, "objective", JsonType::NUMBER).number;
+
+        const JsonValue& metrics = getJsonMember(model, "metrics", JsonType::OBJECT);
+        result.times = readJsonSamples(metrics, "time_ms");
+        result.exploredNodes = readJsonSamples(metrics, "explored_nodes");
+        result.lpIterations = readJsonSamples(metrics, "lp_iterations");
+        result.peakMemory = readJsonSamples(metrics, "peak_memory_kb");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+bool Benchmark::compareSuiteResults(const std::vector<BenchmarkModelResult>& baseline, const std::vector<BenchmarkModelResult>& results, double regressionThreshold) {
+    tabulate::Table table;
+    table.add_row({"Model", "Strategies", "Metric", "Baseline median", "Median", "Change", "p-value", "Verdict"});
+
+    bool regressed = false;
+    uint unmatched = 0;
+    std::vector<bool> baselineMatched(baseline.size(), false);
+    for(const BenchmarkModelResult& result : results) {
+        std::string strategies = convertExplorStratToString(result.explorationStrat) + " " + convertBranchStratToString(result.branchingStrat);
+        std::string modelName = result.modelName;
+
+        const BenchmarkModelResult* baselineResult = NULL;
+        for(uint b = 0; b < baseline.size(); b++) {
+            const BenchmarkModelResult& candidate = baseline[b];
+            bool sameModel = candidate.modelName.empty() ? std::filesystem::path(candidate.fileName).filename() == std::filesystem::path(result.fileName).filename()
+                                                         : candidate.modelName == result.modelName;
+            if(sameModel && candidate.explorationStrat == result.explorationStrat && candidate.branchingStrat == result.branchingStrat) {
+                baselineResult = &candidate;
+                baselineMatched[b] = true;
+            }
+        }
+
+        if(baselineResult == NULL) {
+            table.add_row({modelName, strategies, "", "", "", "", "", "not in the baseline"});
+            table[table.size() - 1][7].format().font_color(tabulate::Color::red);
+            unmatched++;
+            continue;
+        }
+
+        for(bool times : {true, false}) {
+            const std::vector<double>& baselineSamples = times ? baselineResult->times : baselineResult->exploredNodes;
+            const std::vector<double>& currentSamples = times ? result.times : result.exploredNodes;
+            double baselineMedian = computeStatistics(baselineSamples).median, currentMedian = computeStatistics(currentSamples).median;
+
+            double change = (baselineMedian == 0) ? (currentMedian == 0 ? 0 : INFINITY) : (currentMedian - baselineMedian) / baselineMedian * 100;
+            double pValue = getChangePValue(baselineSamples, currentSamples);
+
+            std::string verdict = "-";
+            tabulate::Color color = tabulate::Color::none;
+            if(pValue < BENCHMARK_SIGNIFICANCE_LEVEL && change != 0) {
+                if(std::abs(change) <= regressionThreshold) {
+                    verdict = "within threshold";
+                    color = tabulate::Color::yellow;
+                }
+                else if(change > 0) {
+                    verdict = times ? "slower" : "more nodes";
+                    color = tabulate::Color::red;
+                    regressed = true;
+                }
+                else {
+                    verdict = times ? "faster" : "fewer nodes";
+                    color = tabulate::Color::green;
+                }
+            }
+
+            std::ostringstream changeText, pValueText;
+            changeText << std::showpos << std::fixed << std::setprecision(1) << change << " %";
+            pValueText << std::setprecision(3) << pValue;
+
+            table.add_row({modelName, strategies, times ? "time" : "explored nodes",
+                           times ? formatTime(baselineMedian) : std::to_string((uint)baselineMedian),
+                           times ? formatTime(currentMedian) : std::to_string((uint)currentMedian),
+                           changeText.str(), pValueText.str(), verdict});
+            if(color != tabulate::Color::none) table[table.size() - 1][7].format().font_color(color);
+        }
+    }
+
+    for(uint b = 0; b < baseline.size(); b++) {
+        if(baselineMatched[b]) continue;
+
+        std::string strategies = convertExplorStratToString(baseline[b].explorationStrat) + " " + convertBranchStratToString(baseline[b].branchingStrat);
+        std::string modelName = baseline[b].modelName.empty() ? std::filesystem::path(baseline[b].fileName).filename().string() : baseline[b].modelName;
+        table.add_row({modelName, strategies, "", "", "", "", "", "not in this run"});
+        table[table.size() - 1][7].format().font_color(tabulate::Color::red);
+        unmatched++;
+    }
+
+    std::cout << table << std::endl;
+    if(regressed) std::cout << "Regressions beyond the " << regressionThreshold << " % threshold were found" << std::endl;
+    if(unmatched > 0) std::cout << "Runs only in the baseline or only in this run, which weren't compared: " << unmatched << std::endl;
+
+    return !regressed && unmatched == 0;
+}
+
+void Benchmark::pinToCpu(uint slot) {
+    cpu_set_t allowed;
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) {
+        std::cerr << "Warning: can't read the CPUs the benchmark may run on, not pinning" << std::endl;
+        return;
+    }
+
+    // the slot-th allowed CPU, wrapping around
+    uint target = slot % CPU_COUNT(&allowed);
+    for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if(!CPU_ISSET(cpu, &allowed)) continue;
+        if(target-- > 0) continue;
+
+        cpu_set_t pinned;
+        CPU_ZERO(&pinned);
+        CPU_SET(cpu, &pinned);
+        if(pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned) != 0) std::cerr << "Warning: can't pin a benchmark worker to CPU " << cpu << std::endl;
+        return;
+    }
+}
+
+BenchmarkRun Benchmark::runCell(const BenchmarkCell& cell, bool measureMemory) {
+    BaBTree tree(*cell.problem);
+    tree.setPerfCounters(cell.perfCounters);
+    // other cells' allocations would be counted too when they run on other threads
+    tree.setAllocationTracking(cell.allocationStats && measureMemory);
+
+    if(measureMemory) resetPeakMemory();
+    auto start = std::chrono::steady_clock::now();
+    Matrix optimalWholeSolution = tree.solveTree(cell.explorationStrat, cell.branchingStrat);
+    auto end = std::chrono::steady_clock::now();
+
+    BenchmarkRun run;
+    run.time = std::chrono::duration<double, std::milli>(end - start).count();
+    run.exploredNodes = tree.getMetrics().explored_nodes;
+    run.lpIterations = tree.getMetrics().lp_iterations;
+    run.peakMemory = measureMemory ? getPeakMemory() : 0;
+    run.status = tree.getStatus();
+    run.objective = (run.status == WHOLE_SOLUTION) ? optimalWholeSolution.dotProduct(cell.problem->getObjectiveFunction()) + cell.problem->getObjectiveOffset() : 0;
+    for(uint i = 0; i < N_SOLVE_PHASES; i++) {
+        run.phaseCounters[i] = tree.getMetrics().phase_counters[i];
+        run.phaseAllocations[i] = tree.getMetrics().phase_allocations[i];
+    }
+
+    tree.deleteTree();
+    return run;
+}
+
+std::vector<BenchmarkRun> Benchmark::runCells(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism) {
+    if(parallelism.isolate) return runCellsInProcesses(cells, parallelism);
+    if(parallelism.jobs > 1 || parallelism.pin) return runCellsInThreads(cells, parallelism);
+
+    std::vector<BenchmarkRun> runs;
+    for(const BenchmarkCell& cell : cells) runs.push_back(runCell(cell, true));
+    return runs;
+}
+
+std::vector<BenchmarkRun> Benchmark::runCellsInThreads(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism) {
+    uint jobs = std::max(1u, parallelism.jobs);
+
+    // the peak memory belongs to the whole process, which the threads share
+    if(jobs > 1) std::cerr << "Warning: the peak memory isn't measured when runs share the process, use --isolate to measure it" << std::endl;
+
+    std::vector<BenchmarkRun> runs(cells.size());
+    std::atomic<size_t> nextCell(0);
+    std::vector<std::thread> workers;
+    for(uint slot = 0; slot < jobs; slot++) {
+        workers.push_back(std::thread([&, slot]() {
+            if(parallelism.pin) pinToCpu(slot);
+            for(size_t c = nextCell++; c < cells.size(); c = nextCell++) runs[c] = runCell(cells[c], jobs == 1);
+        }));
+    }
+    for(std::thread& worker : workers) worker.join();
+
+    return runs;
+}
+
+std::vector<BenchmarkRun> Benchmark::runCellsInProcesses(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism) {
+    uint jobs = std::max(1u, parallelism.jobs);
+
+    // the children inherit the output buffers, which would be written twice
+    std::cout.flush();
+    std::cerr.flush();
+
+    std::vector<BenchmarkRun> runs(cells.size());
+    std::map<pid_t, std::tuple<size_t, int, uint>> workers;     // cell, pipe and slot of each running worker
+    std::vector<uint> freeSlots;
+    for(uint slot = jobs; slot > 0; slot--) freeSlots.push_back(slot - 1);
+
+    size_t nextCell = 0;
+    std::string failure;
+    while((nextCell < cells.size() && failure.empty()) || !workers.empty()) {
+        if(nextCell < cells.size() && failure.empty() && !freeSlots.empty()) {
+            uint slot = freeSlots.back();
+            int channel[2];
+            if(pipe(channel) != 0) {
+                failure = "Can't create a pipe for a benchmark worker";
+                continue;
+            }
+
+            pid_t pid = fork();
+            if(pid < 0) {
+                close(channel[0]);
+                close(channel[1]);
+                failure = "Can't start a benchmark worker";
+                continue;
+            }
+            if(pid == 0) {
+                close(channel[0]);
+                int status = 1;
+                try {
+                    if(parallelism.pin) pinToCpu(slot);
+                    BenchmarkRun run = runCell(cells[nextCell], true);
+                    // a single write smaller than PIPE_BUF never blocks on an empty pipe
+                    if(write(channel[1], &run, sizeof(run)) == (ssize_t)sizeof(run)) status = 0;
+                }
+                catch(const std::exception& e) {}
+                _exit(status);
+            }
+
+            close(channel[1]);
+            freeSlots.pop_back();
+            workers[pid] = std::make_tuple(nextCell++, channel[0], slot);
+            continue;
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if(pid < 0 || workers.find(pid) == workers.end()) continue;
+
+        size_t cell = std::get<0>(workers[pid]);
+        int channel = std::get<1>(workers[pid]);
+        freeSlots.push_back(std::get<2>(workers[pid]));
+        workers.erase(pid);
+
+        if(read(channel, &runs[cell], sizeof(BenchmarkRun)) != (ssize_t)sizeof(BenchmarkRun) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failure = "A benchmark worker process failed";
+        }
+        close(channel);
+    }
+
+    if(!failure.empty()) throw std::invalid_argument(failure);
+    return runs;
+}
+
+std::vector<BenchmarkRun> Benchmark::executeCells(const std::vector<BenchmarkCell>& cells, const BenchmarkParallelism& parallelism, const std::vector<std::string>& groupNames) {
+    if(!parallelism.contention) return runCells(cells, parallelism);
+
+    BenchmarkParallelism serial = parallelism;
+    serial.jobs = 1;
+    std::vector<BenchmarkRun> serialRuns = runCells(cells, serial);
+    std::vector<BenchmarkRun> parallelRuns = runCells(cells, parallelism);
+
+    displayContention(cells, serialRuns, parallelRuns, groupNames);
+    return serialRuns;
+}
+
+void Benchmark::displayContention(const std::vector<BenchmarkCell>& cells, const std::vector<BenchmarkRun>& serialRuns, const std::vector<BenchmarkRun>& parallelRuns,
+                                  const std::vector<std::string>& groupNames) {
+    std::vector<std::vector<double>> serialTimes(groupNames.size()), parallelTimes(groupNames.size());
+    for(uint c = 0; c < cells.size(); c++) {
+        if(!cells[c].measured) continue;
+        serialTimes[cells[c].group].push_back(serialRuns[c].time);
+        parallelTimes[cells[c].group].push_back(parallelRuns[c].time);
+    }
+
+    tabulate::Table table;
+    table.add_row({"Cells", "Serial median", "Parallel median", "Slowdown", "p-value", "Contention"});
+
+    bool contended = false;
+    for(uint g = 0; g < groupNames.size(); g++) {
+        if(serialTimes[g].empty()) continue;
+
+        double serialMedian = computeStatistics(serialTimes[g]).median, parallelMedian = computeStatistics(parallelTimes[g]).median;
+        double slowdown = parallelMedian / serialMedian;
+        double pValue = mannWhitneyPValue(serialTimes[g], parallelTimes[g]);
+        bool groupContended = slowdown > 1.1 && pValue < BENCHMARK_SIGNIFICANCE_LEVEL;
+        contended = contended || groupContended;
+
+        std::ostringstream slowdownText, pValueText;
+        slowdownText << std::fixed << std::setprecision(2) << slowdown << "x";
+        pValueText << std::setprecision(3) << pValue;
+        table.add_row({groupNames[g], formatTime(serialMedian), formatTime(parallelMedian), slowdownText.str(), pValueText.str(), groupContended ? "yes" : "-"});
+        if(groupContended) table[table.size() - 1][5].format().font_color(tabulate::Color::red);
+    }
+
+    std::cout << table << std::endl;
+    if(contended) std::cout << "Parallel runs are significantly slower than serial ones: the reported results are those of the serial runs" << std::endl;
+}
+
 // PUBLIC METHODS
 
 Benchmark::Benchmark(uint numIterations) {
@@ -40,51 +695,145 @@ Benchmark::Benchmark(uint numIterations) {
     possibleBranchStrats = getPossibleBranchingStrategies();
 }
 
-void Benchmark::runBenchmark() {
-    double avg_execution_time;
-    double avg_explored_nodes;
-    uint currentIndex = 0;
-    uint deterministic_nodes;
+void Benchmark::runBenchmark(const BenchmarkParallelism& parallelism) {
+    // the model is read once, every run solves its own copy
+    LpProblem benchmarkProblem = ModelFileReader::readModel("bench.lp");
 
-    for(int i = 0; i < possibleExplorStrats.size(); i++) {
-        ExplorationStrategy currentExplorStrat = possibleExplorStrats[i];
-        for(int j = 0; j < possibleBranchStrats.size(); j++) {
-            BranchingStrategy currentBranchStrat = possibleBranchStrats[j];
+    // one cell per run of each pair of strategies, grouped by pair
+    std::vector<BenchmarkCell> cells;
+    std::vector<std::string> pairNames;
+    for(uint i = 0; i < possibleExplorStrats.size(); i++) {
+        for(uint j = 0; j < possibleBranchStrats.size(); j++) {
+            metrics.strats.push_back(std::make_pair(possibleExplorStrats[i], possibleBranchStrats[j]));
+            pairNames.push_back(convertExplorStratToString(possibleExplorStrats[i]) + " " + convertBranchStratToString(possibleBranchStrats[j]));
+            for(uint k = 0; k < iterations; k++) cells.push_back({&benchmarkProblem, possibleExplorStrats[i], possibleBranchStrats[j], (uint)pairNames.size() - 1, true, false, false});
+        }
+    }
+    std::vector<BenchmarkRun> runs = executeCells(cells, parallelism, pairNames);
 
-            avg_execution_time = 0;
-            avg_explored_nodes = 0;
+    for(uint pair = 0; pair < metrics.strats.size(); pair++) {
+        ExplorationStrategy currentExplorStrat = metrics.strats[pair].first;
+        BranchingStrategy currentBranchStrat = metrics.strats[pair].second;
 
-            for(int k = 0; k < iterations; k++) {
-                LpProblem initialProblem = ModelFileReader::readModel("bench.lp");
-                BaBTree tree(initialProblem);
-                Matrix optimalWholeSolution = tree.solveTree(currentExplorStrat, currentBranchStrat);
+        double avg_execution_time = 0;
+        double avg_explored_nodes = 0;
+        double avg_lp_iterations = 0;
+        uint deterministic_nodes = 0;
+        for(uint c = 0; c < cells.size(); c++) {
+            if(cells[c].group != pair) continue;
 
-                avg_execution_time += tree.getMetrics().execution_time / iterations;
-                avg_explored_nodes += ((double)tree.getMetrics().explored_nodes / (double)iterations);
+            avg_execution_time += runs[c].time / iterations;
+            avg_explored_nodes += ((double)runs[c].exploredNodes / (double)iterations);
+            avg_lp_iterations += ((double)runs[c].lpIterations / (double)iterations);
+            deterministic_nodes = runs[c].exploredNodes;
+        }
 
-                tree.deleteTree();
+        metrics.avg_execution_times.push_back(avg_execution_time);
+        metrics.lp_iterations.push_back(avg_lp_iterations);
 
-                if(currentBranchStrat != BranchingStrategy::RANDOM_VAR && currentExplorStrat != ExplorationStrategy::RANDOM_NODE) {
-                    deterministic_nodes = tree.getMetrics().explored_nodes;
-                }
-            }
+        if(currentBranchStrat != BranchingStrategy::RANDOM_VAR && currentExplorStrat != ExplorationStrategy::RANDOM_NODE) {
+            metrics.explored_nodes.push_back(deterministic_nodes);
+            metrics.things.push_back(std::make_tuple(avg_execution_time, std::make_pair(currentExplorStrat, currentBranchStrat), deterministic_nodes, avg_lp_iterations));
+        }
+        else {
+            metrics.explored_nodes.push_back(avg_explored_nodes);
+            metrics.things.push_back(std::make_tuple(avg_execution_time, std::make_pair(currentExplorStrat, currentBranchStrat), avg_explored_nodes, avg_lp_iterations));
+        }
+    }
 
-            metrics.strats.push_back(std::make_pair(currentExplorStrat, currentBranchStrat));
-            metrics.avg_execution_times.push_back(avg_execution_time);
+    displayBenchmarkResults(0);
+    displayScalingResults(benchmarkProblem);
+}
 
-            
-            if(currentBranchStrat != BranchingStrategy::RANDOM_VAR && currentExplorStrat != ExplorationStrategy::RANDOM_NODE) {
-                metrics.explored_nodes.push_back(deterministic_nodes);
-                metrics.things.push_back(std::make_tuple(avg_execution_time, std::make_pair(currentExplorStrat, currentBranchStrat), deterministic_nodes));
-            }
-            else {
-                metrics.explored_nodes.push_back(avg_explored_nodes);
-                metrics.things.push_back(std::make_tuple(avg_execution_time, std::make_pair(currentExplorStrat, currentBranchStrat), avg_explored_nodes));
+void Benchmark::runLoadBenchmark(std::string fileName, bool useCache, uint threads) {
+    double fileSize = (double)std::filesystem::file_size(fileName) / (1024 * 1024);
+    double totalTime = 0, minTime = INFINITY;
+
+    for(uint k = 0; k < iterations; k++) {
+        auto start = std::chrono::steady_clock::now();
+        LpProblem problem = ModelFileReader::readModel(fileName, useCache, threads);
+        auto end = std::chrono::steady_clock::now();
+
+        double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+        totalTime += elapsed;
+        minTime = std::min(minTime, elapsed);
+    }
+
+    double avgTime = totalTime / iterations;
+
+    tabulate::Table results;
+    results.add_row({"File size", "Average load time", "Minimum load time", "Throughput"});
+    results.add_row({std::to_string(fileSize) + " MB", std::to_string(avgTime) + " ms", std::to_string(minTime) + " ms",
+                     std::to_string(fileSize / (minTime / 1000)) + " MB/s"});
+
+    std::cout << results << std::endl;
+}
+
+bool Benchmark::runSuite(const BenchmarkSuiteOptions& options) {
+    std::vector<std::string> models = getSuiteModels(options.path);
+
+    // read the baseline first, so a bad baseline fails before the benchmark runs
+    std::vector<BenchmarkModelResult> baseline;
+    if(!options.baselineFile.empty()) baseline = readSuiteJson(options.baselineFile);
+
+    if(!resetPeakMemory()) std::cerr << "Warning: the peak memory can't be reset, every run reports the peak of the whole benchmark" << std::endl;
+
+    // the models are read once, every run solves its own copy
+    std::vector<LpProblem> problems;
+    std::vector<std::string> names;
+    std::vector<PerfCounts> parseCounts;
+    std::vector<AllocationStats> parseAllocations;
+    for(const std::string& model : models) {
+        try {
+            std::shared_ptr<PerfCounters> counters;
+            if(options.perfCounters) {
+                counters = std::make_shared<PerfCounters>();
+                counters->start();
             }
+            AllocationCounter allocations;
+            if(options.allocationStats) allocations.start();
+            problems.push_back(ModelFileReader::readModel(model));
+            parseAllocations.push_back(allocations.stop());
+            parseCounts.push_back((counters != NULL) ? counters->stop() : emptyPerfCounts());
+            names.push_back(model);
+        }
+        catch(const std::invalid_argument& e) {
+            std::cerr << "Warning: skipping " << model << ": " << e.what() << std::endl;
+        }
+    }
 
-            currentIndex++;
+    std::vector<BenchmarkModelResult> results = benchmarkModels(problems, names, options, parseCounts, parseAllocations);
+    for(BenchmarkModelResult& result : results) result.modelName = getSuiteModelName(options.path, result.fileName);
+    displaySuiteResults(results);
+    return reportSuiteResults(results, baseline, options);
+}
+
+bool Benchmark::runSweep(const BenchmarkSweep& sweep, const BenchmarkSuiteOptions& options) {
+    std::vector<BenchmarkModelResult> baseline;
+    if(!options.baselineFile.empty()) baseline = readSuiteJson(options.baselineFile);
+
+    if(!resetPeakMemory()) std::cerr << "Warning: the peak memory can't be reset, every run reports the peak of the whole benchmark" << std::endl;
+
+    std::vector<BenchmarkModelResult> results;
+    std::vector<uint> sizes;
+    for(uint size : sweep.sizes) {
+        GeneratorOptions generatorOptions = sweep.model;
+        generatorOptions.size = size;
+        SparseModel model = ModelGenerator::generate(generatorOptions);
+        std::vector<LpProblem> problems = {sparseModelToLpProblem(model)};
+
+        results.push_back(benchmarkModels(problems, {model.name}, options)[0]);
+        sizes.push_back(size);
+
+        double medianTime = computeStatistics(results.back().times).median;
+        if(medianTime > sweep.timeLimit) {
+            std::cout << "Stopping the sweep at size " << size << ": its median execution time(" << formatTime(medianTime) << ") exceeds the "
+                      << formatTime(sweep.timeLimit) << " limit" << std::endl;
+            break;
         }
     }
 
-    displayBenchmarkResults(0);
+    displaySuiteResults(results);
+    displaySweepResults(results, sizes);
+    return reportSuiteResults(results, baseline, options);
 }
\ No newline at end of file
@@ -1,72 +1,363 @@
 #include "../../include/cli/cli.h"
 
 #include <filesystem>
+#include <cstdlib>
 #include <iostream>
+#include <thread>
 
 #include "../../include/model_reader.h"
 #include "../../include/cli/benchmark.h"
+#include "../../include/portfolio.h"
+#include "../../include/model_writer.h"
+#include "../../include/model_generator.h"
+#include "../../include/trace.h"
+#include "../../include/node_log.h"
+#include "../../include/progress.h"
 
 // PRIVATE METHODS
 
+std::string CLI::resolveModelFile(const std::string& argument) {
+    if(argument == STDIN_FILE_NAME) return argument;
+
+    // the model file can be given with or without its .lp extension. Anything that can be opened is accepted(e.g. named pipes), and
+    // compressed files are recognized by their contents
+    if(std::filesystem::exists(argument) && !std::filesystem::is_directory(argument)) return argument;
+    if(std::filesystem::exists(argument + ".lp")) return argument + ".lp";
+    throw std::invalid_argument("Model file does not exist: " + argument);
+}
+
+uint CLI::parseThreadCount(const std::string& argument) {
+    uint threads;
+    try {
+        threads = std::stoul(argument);
+    }
+    catch(const std::exception& e) {
+        throw std::invalid_argument("Invalid number of threads: " + argument);
+    }
+
+    // 0 uses every hardware thread
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return threads;
+}
+
+uint CLI::parseCount(const std::string& option, const std::string& argument) {
+    try {
+        return std::stoul(argument);
+    }
+    catch(const std::exception& e) {
+        throw std::invalid_argument("Invalid value for " + option + ": " + argument);
+    }
+}
+
+double CLI::parseNonNegative(const std::string& option, const std::string& argument) {
+    double value;
+    try {
+        value = std::stod(argument);
+    }
+    catch(const std::exception& e) {
+        throw std::invalid_argument("Invalid value for " + option + ": " + argument);
+    }
+
+    if(!(value >= 0)) throw std::invalid_argument("Invalid value for " + option + ": " + argument);
+    return value;
+}
+
+bool CLI::parseSuiteOption(uint& i) {
+    if(args[i] == "--warmup" && i + 1 < args.size()) command.suite.warmupRuns = parseCount(args[i], args[i + 1]), i++;
+    else if(args[i] == "--runs" && i + 1 < args.size()) command.suite.measuredRuns = parseCount(args[i], args[i + 1]), i++;
+    else if(args[i] == "--strategy" && i + 2 < args.size()) {
+        command.suite.explorationStrat = convertStringToExplorStrat(args[++i]);
+        command.suite.branchingStrat = convertStringToBranchStrat(args[++i]);
+    }
+    else if(args[i] == "--json" && i + 1 < args.size()) command.suite.jsonFile = args[++i];
+    else if(args[i] == "--csv" && i + 1 < args.size()) command.suite.csvFile = args[++i];
+    else if(args[i] == "--compare" && i + 1 < args.size()) command.suite.baselineFile = args[++i];
+    else if(args[i] == "--threshold" && i + 1 < args.size()) command.suite.regressionThreshold = parseNonNegative(args[i], args[i + 1]), i++;
+    else if(args[i] == "--perf-counters") command.suite.perfCounters = true;
+    else if(args[i] == "--alloc-stats") command.suite.allocationStats = true;
+    else return false;
+
+    return true;
+}
+
+bool CLI::parseParallelismOption(uint& i) {
+    if(args[i] == "--jobs" && i + 1 < args.size()) command.suite.parallelism.jobs = parseThreadCount(args[++i]);
+    else if(args[i] == "--isolate") command.suite.parallelism.isolate = true;
+    else if(args[i] == "--pin") command.suite.parallelism.pin = true;
+    else if(args[i] == "--contention") command.suite.parallelism.contention = true;
+    else return false;
+
+    return true;
+}
+
+bool CLI::parseGeneratorOption(uint& i) {
+    if(args[i] == "--rows" && i + 1 < args.size()) command.sweep.model.rows = parseCount(args[i], args[i + 1]), i++;
+    else if(args[i] == "--density" && i + 1 < args.size()) command.sweep.model.density = parseNonNegative(args[i], args[i + 1]), i++;
+    else if(args[i] == "--seed" && i + 1 < args.size()) command.sweep.model.seed = parseCount(args[i], args[i + 1]), i++;
+    else return false;
+
+    return true;
+}
+
 void CLI::validateCommand() {
+    command.suite.parallelism.jobs = 1;
+    command.suite.parallelism.isolate = false;
+    command.suite.parallelism.pin = false;
+    command.suite.parallelism.contention = false;
 
     if(args.size() == 2) {
         if(args[1] != "--benchmark") throw std::invalid_argument("Invalid number of arguments");
     }
+    else if(args.size() >= 3 && args[1] == "--benchmark-load") {
+        command.fileName = resolveModelFile(args[2]);
+        if(command.fileName == STDIN_FILE_NAME) throw std::invalid_argument("The load benchmark needs a model file");
+
+        command.modelCache = false;
+        command.parseThreads = 1;
+        for(uint i = 3; i < args.size(); i++) {
+            if(args[i] == "--model-cache") command.modelCache = true;
+            else if(args[i] == "--parse-threads" && i + 1 < args.size()) command.parseThreads = parseThreadCount(args[++i]);
+            else throw std::invalid_argument("Invalid option: " + args[i]);
+        }
+    }
+    else if((args.size() >= 3 && args[1] == "--benchmark") || (args.size() >= 4 && args[1] == "--benchmark-sweep")) {
+        command.suite.warmupRuns = 1;
+        command.suite.measuredRuns = 10;
+        command.suite.explorationStrat = ExplorationStrategy::BEST_VALUE;
+        command.suite.branchingStrat = BranchingStrategy::FIRST_INDEX;
+        command.suite.regressionThreshold = 5;
+        command.suite.perfCounters = false;
+        command.suite.allocationStats = false;
+
+        uint firstOption = 3;
+        if(args[1] == "--benchmark") {
+            // without a suite, the options are those of the strategy comparison
+            if(args[2].compare(0, 2, "--") == 0) firstOption = 2;
+            else command.suite.path = args[2];
+        }
+        else {
+            command.sweep.model = ModelGenerator::defaultOptions(convertStringToModelFamily(args[2]));
+            command.sweep.timeLimit = 10000;
+
+            // comma separated sizes, e.g. 10,20,40
+            size_t start = 0;
+            while(start <= args[3].size()) {
+                size_t end = std::min(args[3].find(',', start), args[3].size());
+                command.sweep.sizes.push_back(parseCount("the sweep sizes", args[3].substr(start, end - start)));
+                start = end + 1;
+            }
+            firstOption = 4;
+        }
+
+        for(uint i = firstOption; i < args.size(); i++) {
+            if(parseParallelismOption(i)) continue;
+            else if(firstOption > 2 && parseSuiteOption(i)) continue;
+            else if(args[1] == "--benchmark-sweep" && parseGeneratorOption(i)) continue;
+            else if(args[1] == "--benchmark-sweep" && args[i] == "--time-limit" && i + 1 < args.size()) command.sweep.timeLimit = parseNonNegative(args[i], args[i + 1]), i++;
+            else throw std::invalid_argument("Invalid option: " + args[i]);
+        }
+
+        if(command.suite.measuredRuns == 0) throw std::invalid_argument("The benchmark needs at least one measured run");
+    }
+    else if(args.size() == 4 && args[1] == "--export-tree") {
+        command.fileName = args[2];
+        command.treeExportFile = args[3];
+
+        std::string extension = std::filesystem::path(command.treeExportFile).extension().string();
+        if(extension != ".dot" && extension != ".json") throw std::invalid_argument("The tree can only be exported to .dot or .json files: " + command.treeExportFile);
+    }
+    else if(args.size() >= 5 && args[1] == "--generate") {
+        command.sweep.model = ModelGenerator::defaultOptions(convertStringToModelFamily(args[2]));
+        command.sweep.model.size = parseCount("the model size", args[3]);
+        command.fileName = args[4];
+        for(uint i = 5; i < args.size(); i++) {
+            if(!parseGeneratorOption(i)) throw std::invalid_argument("Invalid option: " + args[i]);
+        }
+    }
     else {
-        if(args.size() != 5) {
+        if(args.size() < 5) {
             throw std::invalid_argument("Invalid number of arguments size 5");
         }
         
-        // file doesn't exist
-        if(!std::filesystem::exists(args[1] + ".lp")) {
-            throw std::invalid_argument("Model file does not exist");
-        }
-        else command.fileName = args[1] + ".lp";
+        command.fileName = resolveModelFile(args[1]);
 
-        if(args[2] == "BEST_VALUE") command.explorationStrat = ExplorationStrategy::BEST_VALUE;
-        else if(args[2] == "EXPLORE_ALL_NODES") command.explorationStrat = ExplorationStrategy::EXPLORE_ALL_NODES;
-        else if(args[2] == "WIDTH") command.explorationStrat = ExplorationStrategy::WIDTH;
-        else if(args[2] == "DEPTH") command.explorationStrat = ExplorationStrategy::DEPTH;
-        else if(args[2] == "RANDOM_NODE") command.explorationStrat = ExplorationStrategy::RANDOM_NODE;
-        else throw std::invalid_argument("Invalid exploration strategy");
-
-        if(args[3] == "FIRST_INDEX") command.branchingStrat = BranchingStrategy::FIRST_INDEX;
-        else if(args[3] == "RANDOM_VAR") command.branchingStrat = BranchingStrategy::RANDOM_VAR;
-        else if(args[3] == "BEST_COEFFICIENT") command.branchingStrat = BranchingStrategy::BEST_COEFFICIENT;
-        else throw std::invalid_argument("Invalid branching strategy");
+        command.explorationStrat = convertStringToExplorStrat(args[2]);
+        command.branchingStrat = convertStringToBranchStrat(args[3]);
 
         if(args[4] == "--show") command.displayResults = true;
         else if(args[4] == "--quiet") command.displayResults = false;
         else throw std::invalid_argument("Invalid option: " + args[4]);
+
+        // optional flags
+        command.scaling = true;
+        command.rootAlgorithm = SIMPLEX;
+        command.crossover = true;
+        command.concurrentRoot = false;
+        command.portfolio = false;
+        command.modelCache = false;
+        command.parseThreads = 1;
+        command.dumpExtension = ".lp";
+        command.resultCache = true;
+        command.perfCounters = false;
+        command.allocationStats = false;
+        command.progressInterval = 0;
+        for(uint i = 5; i < args.size(); i++) {
+            if(args[i] == "--no-scaling") command.scaling = false;
+            else if(args[i] == "--barrier") command.rootAlgorithm = BARRIER;
+            else if(args[i] == "--no-crossover") command.crossover = false;
+            else if(args[i] == "--concurrent-root") command.concurrentRoot = true;
+            else if(args[i] == "--portfolio") command.portfolio = true;
+            else if(args[i] == "--model-cache") command.modelCache = true;
+            else if(args[i] == "--parse-threads" && i + 1 < args.size()) command.parseThreads = parseThreadCount(args[++i]);
+            else if(args[i] == "--no-cache") command.resultCache = false;
+            else if(args[i] == "--perf-counters") command.perfCounters = true;
+            else if(args[i] == "--alloc-stats") command.allocationStats = true;
+            else if(args[i] == "--trace" && i + 1 < args.size()) command.traceFile = args[++i];
+            else if(args[i] == "--node-log" && i + 1 < args.size()) command.nodeLogFile = args[++i];
+            else if(args[i] == "--progress" && i + 1 < args.size()) {
+                command.progressInterval = parseNonNegative(args[i], args[i + 1]), i++;
+                if(command.progressInterval <= 0) throw std::invalid_argument("The progress interval must be positive");
+            }
+            else if(args[i] == "--dump-models" && i + 1 < args.size()) command.dumpDirectory = args[++i];
+            else if(args[i] == "--dump-format" && i + 1 < args.size()) {
+                i++;
+                if(args[i] == "lp") command.dumpExtension = ".lp";
+                else if(args[i] == "mps") command.dumpExtension = ".mps";
+                else throw std::invalid_argument("Invalid dump format: " + args[i]);
+            }
+            else throw std::invalid_argument("Invalid option: " + args[i]);
+        }
+
+        // the trees of a portfolio would overwrite each other's dumps
+        if(command.portfolio && !command.dumpDirectory.empty()) throw std::invalid_argument("--dump-models can't be used with --portfolio");
+        if(command.portfolio && command.perfCounters) throw std::invalid_argument("--perf-counters can't be used with --portfolio");
+        if(command.portfolio && command.allocationStats) throw std::invalid_argument("--alloc-stats can't be used with --portfolio");
+        if(command.portfolio && !command.nodeLogFile.empty()) throw std::invalid_argument("--node-log can't be used with --portfolio");
+        if(command.portfolio && command.progressInterval > 0) throw std::invalid_argument("--progress can't be used with --portfolio");
+#ifdef NO_TRACE
+        if(!command.traceFile.empty()) throw std::invalid_argument("--trace needs a build with tracing(make TRACE=1)");
+#endif
     }
 
 }
 
 void CLI::executeCommand() {
-    if(args.size() == 2 && args[1] == "--benchmark") {
+    if(args[1] == "--benchmark" && command.suite.path.empty()) {
         benchmark();
         return;
     }
+    else if(args[1] == "--benchmark") {
+        Benchmark bench;
+        if(!bench.runSuite(command.suite)) exitCode = EXIT_REGRESSION;
+        return;
+    }
+    else if(args[1] == "--benchmark-sweep") {
+        Benchmark bench;
+        if(!bench.runSweep(command.sweep, command.suite)) exitCode = EXIT_REGRESSION;
+        return;
+    }
+    else if(args[1] == "--generate") {
+        LpProblem problem = sparseModelToLpProblem(ModelGenerator::generate(command.sweep.model));
+        ModelFileWriter::writeModel(problem, command.fileName);
+        return;
+    }
+    else if(args[1] == "--export-tree") {
+        std::vector<NodeRecord> records = NodeLog::read(command.fileName);
+        if(std::filesystem::path(command.treeExportFile).extension() == ".dot") NodeLog::writeDot(records, command.treeExportFile);
+        else NodeLog::writeJson(records, command.treeExportFile);
+        return;
+    }
+    else if(args[1] == "--benchmark-load") {
+        Benchmark bench;
+        bench.runLoadBenchmark(command.fileName, command.modelCache, command.parseThreads);
+        return;
+    }
+
+    if(!command.traceFile.empty()) Tracer::start();
+
+    std::shared_ptr<PerfCounters> parseCounters;
+    if(command.perfCounters) {
+        parseCounters = std::make_shared<PerfCounters>();
+        parseCounters->start();
+    }
+    AllocationCounter parseAllocations;
+    if(command.allocationStats) parseAllocations.start();
+    LpProblem initialProblem;
+    {
+        TRACE_SCOPE("parse", "phase");
+        initialProblem = ModelFileReader::readModel(command.fileName, command.modelCache, command.parseThreads);
+    }
+    AllocationStats parseAllocationStats = parseAllocations.stop();
+    PerfCounts parseCounts = (parseCounters != NULL) ? parseCounters->stop() : emptyPerfCounts();
 
-    LpProblem initialProblem = ModelFileReader::readModel(command.fileName);
+    if(command.portfolio) {
+        // one tree per hardware thread, starting with the strategies the user chose
+        uint portfolioSize = std::max(2u, std::thread::hardware_concurrency());
+        Portfolio portfolio(initialProblem, Portfolio::defaultStrategies(std::make_pair(command.explorationStrat, command.branchingStrat), portfolioSize));
+        portfolio.setScaling(command.scaling);
+        portfolio.setRootAlgorithm(command.rootAlgorithm, command.crossover);
+        portfolio.setConcurrentRoot(command.concurrentRoot);
+        Matrix optimalWholeSolution = portfolio.solve();
+
+        if(command.displayResults) portfolio.displayProblem(optimalWholeSolution);
+        if(!command.traceFile.empty()) Tracer::write(command.traceFile);
+
+        portfolio.deleteTrees();
+        return;
+    }
+
+    if(!command.dumpDirectory.empty()) std::filesystem::create_directories(command.dumpDirectory);
 
     BaBTree tree(initialProblem);
+    tree.setScaling(command.scaling);
+    tree.setModelDump(command.dumpDirectory, command.dumpExtension);
+    tree.setPerfCounters(command.perfCounters);
+    tree.setPhaseCounters(PARSE_PHASE, parseCounts);
+    tree.setAllocationTracking(command.allocationStats);
+    tree.setPhaseAllocations(PARSE_PHASE, parseAllocationStats);
+    tree.setNodeRecording(!command.nodeLogFile.empty());
+
+    // the status lines go to the standard error, so they don't mix with the results
+    std::shared_ptr<ProgressReporter> progressReporter;
+    if(command.progressInterval > 0) {
+        progressReporter = std::make_shared<ProgressReporter>(command.progressInterval);
+        tree.setProgressReporter(progressReporter);
+        progressReporter->start();
+    }
+
+    // dumps, performance counters, allocations, traces and node logs are taken while the tree is solved, so a cached result would skip them
+    std::string cacheDirectory = ResultCache::defaultDirectory();
+    bool instrumented = !command.dumpDirectory.empty() || command.perfCounters || command.allocationStats || !command.traceFile.empty() ||
+                        !command.nodeLogFile.empty();
+    if(command.resultCache && !instrumented && !cacheDirectory.empty()) {
+        try {
+            tree.setResultCache(std::make_shared<ResultCache>(cacheDirectory));
+        }
+        catch(const std::invalid_argument& e) {
+            std::cerr << "Warning: " << e.what() << std::endl;
+        }
+    }
+    tree.setRootAlgorithm(command.rootAlgorithm, command.crossover);
+    tree.setConcurrentRoot(command.concurrentRoot);
     Matrix optimalWholeSolution = tree.solveTree(command.explorationStrat, command.branchingStrat);
+    if(progressReporter != NULL) progressReporter->stop();
 
     if(command.displayResults) tree.displayProblem(optimalWholeSolution);
+    if(!command.traceFile.empty()) Tracer::write(command.traceFile);
+    if(!command.nodeLogFile.empty()) NodeLog::write(tree.getNodeRecords(), command.nodeLogFile);
 
     tree.deleteTree();
 }
 
 void CLI::benchmark() {
     Benchmark bench;
-    bench.runBenchmark();
+    bench.runBenchmark(command.suite.parallelism);
 }
 
 // PUBLIC METHODS
 
 CLI::CLI(int argc, char** argv) {
+    exitCode = EXIT_SUCCESS;
     for(int i = 0; i < argc; i++) {
         args.push_back(std::string(argv[i]));
     }
@@ -78,5 +369,6 @@ CLI::CLI(int argc, char** argv) {
     catch(const std::exception& e)
     {
         std::cerr << e.what() << '\n';
+        exitCode = EXIT_FAILURE;
     }
 }
\ No newline at end of file
@@ -37,4 +37,14 @@ void Constraint::removeFixedVariable(int varIndex, double varValue) {
     double coeff = lhs[varIndex];
     rhs -= coeff * varValue;
     lhs.erase(lhs.begin() + varIndex);
+}
+
+void Constraint::normalizeRhs() {
+    if(rhs >= 0) return;
+
+    for(double& coefficient : lhs) coefficient = -coefficient;
+    rhs = -rhs;
+
+    if(type == LESS_THAN_OR_EQUAL) type = GREATER_THAN_OR_EQUAL;
+    else if(type == GREATER_THAN_OR_EQUAL) type = LESS_THAN_OR_EQUAL;
 }
\ No newline at end of file
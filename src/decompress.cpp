@@ -0,0 +1,101 @@
+#include "decompress.h"
+
+#include <stdexcept>
+#include <zlib.h>
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+std::string inflateGzip(std::string_view data) {
+    z_stream stream = {};
+    // 15 + 32: maximum window, and detection of the gzip or zlib header
+    if(inflateInit2(&stream, 15 + 32) != Z_OK) throw std::invalid_argument("Cannot initialize gzip decompression");
+
+    std::string output;
+    stream.next_in = (Bytef*)data.data();
+    stream.avail_in = data.size();
+
+    int result = Z_OK;
+    while(true) {
+        size_t used = output.size();
+        output.resize(used + DECOMPRESS_BLOCK_SIZE);
+        stream.next_out = (Bytef*)&output[used];
+        stream.avail_out = DECOMPRESS_BLOCK_SIZE;
+
+        result = inflate(&stream, Z_NO_FLUSH);
+        output.resize(used + DECOMPRESS_BLOCK_SIZE - stream.avail_out);
+
+        if(result == Z_STREAM_END) {
+            // another gzip member follows
+            if(stream.avail_in > 0 && inflateReset(&stream) == Z_OK) continue;
+            break;
+        }
+        if(result != Z_OK) {
+            inflateEnd(&stream);
+            if(result == Z_BUF_ERROR) throw std::invalid_argument("Truncated gzip data");
+            throw std::invalid_argument("Corrupted gzip data");
+        }
+    }
+
+    inflateEnd(&stream);
+    return output;
+}
+
+#ifdef WITH_ZSTD
+std::string decompressZstd(std::string_view data) {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    if(context == NULL) throw std::invalid_argument("Cannot initialize zstd decompression");
+
+    std::string output;
+    ZSTD_inBuffer input = {data.data(), data.size(), 0};
+    size_t result = 0;
+    while(input.pos < input.size) {
+        size_t used = output.size();
+        output.resize(used + DECOMPRESS_BLOCK_SIZE);
+        ZSTD_outBuffer block = {&output[used], DECOMPRESS_BLOCK_SIZE, 0};
+
+        result = ZSTD_decompressStream(context, &block, &input);
+        output.resize(used + block.pos);
+        if(ZSTD_isError(result)) {
+            ZSTD_freeDCtx(context);
+            throw std::invalid_argument(std::string("Corrupted zstd data: ") + ZSTD_getErrorName(result));
+        }
+    }
+
+    // the last frame isn't complete
+    if(result != 0) {
+        ZSTD_freeDCtx(context);
+        throw std::invalid_argument("Truncated zstd data");
+    }
+
+    ZSTD_freeDCtx(context);
+    return output;
+}
+#endif
+
+}
+
+Compression detectCompression(std::string_view data) {
+    if(data.size() >= 2 && (unsigned char)data[0] == 0x1f && (unsigned char)data[1] == 0x8b) return Compression::GZIP;
+    if(data.size() >= 4 && (unsigned char)data[0] == 0x28 && (unsigned char)data[1] == 0xb5 && (unsigned char)data[2] == 0x2f &&
+       (unsigned char)data[3] == 0xfd) {
+        return Compression::ZSTD;
+    }
+    return Compression::NONE;
+}
+
+std::string decompress(std::string_view data, Compression compression) {
+    if(compression == Compression::GZIP) return inflateGzip(data);
+
+    if(compression == Compression::ZSTD) {
+#ifdef WITH_ZSTD
+        return decompressZstd(data);
+#else
+        throw std::invalid_argument("zstd compressed models aren't supported by this build(rebuild with make ZSTD=1)");
+#endif
+    }
+
+    return std::string(data);
+}
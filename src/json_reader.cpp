@@ -0,0 +1,190 @@
+#include "json_reader.h"
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+// PRIVATE METHODS
+
+JsonReader::JsonReader(std::string_view text) {
+    input = text;
+    position = 0;
+}
+
+void JsonReader::error(const std::string& message) {
+    std::ostringstream errorMessage;
+    errorMessage << "Invalid JSON at offset " << position << ": " << message;
+    throw std::invalid_argument(errorMessage.str());
+}
+
+void JsonReader::skipWhitespace() {
+    while(position < input.size() && (input[position] == ' ' || input[position] == '\t' || input[position] == '\n' || input[position] == '\r')) position++;
+}
+
+void JsonReader::expect(char character) {
+    skipWhitespace();
+    if(position >= input.size() || input[position] != character) error(std::string("expected '") + character + "'");
+    position++;
+}
+
+std::string JsonReader::readString() {
+    expect('"');
+
+    std::string text;
+    while(true) {
+        if(position >= input.size()) error("unterminated string");
+
+        char character = input[position++];
+        if(character == '"') return text;
+        if(character != '\\') {
+            text += character;
+            continue;
+        }
+
+        if(position >= input.size()) error("unterminated string");
+        char escape = input[position++];
+        switch(escape) {
+        case '"': case '\\': case '/': text += escape; break;
+        case 'b': text += '\b'; break;
+        case 'f': text += '\f'; break;
+        case 'n': text += '\n'; break;
+        case 'r': text += '\r'; break;
+        case 't': text += '\t'; break;
+        case 'u': {
+            uint codePoint;
+            if(position + 4 > input.size() || std::from_chars(input.data() + position, input.data() + position + 4, codePoint, 16).ptr != input.data() + position + 4) {
+                error("invalid \\u escape");
+            }
+            position += 4;
+
+            // surrogate pairs aren't combined, which only matters outside the basic multilingual plane
+            if(codePoint < 0x80) text += (char)codePoint;
+            else if(codePoint < 0x800) {
+                text += (char)(0xC0 | (codePoint >> 6));
+                text += (char)(0x80 | (codePoint & 0x3F));
+            }
+            else {
+                text += (char)(0xE0 | (codePoint >> 12));
+                text += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+                text += (char)(0x80 | (codePoint & 0x3F));
+            }
+            break;
+        }
+        default:
+            error(std::string("invalid escape '\\") + escape + "'");
+        }
+    }
+}
+
+JsonValue JsonReader::readValue() {
+    JsonValue value;
+    value.type = JsonType::NULL_VALUE;
+    value.boolean = false;
+    value.number = 0;
+
+    skipWhitespace();
+    if(position >= input.size()) error("unexpected end of input");
+
+    char character = input[position];
+    if(character == '{') {
+        value.type = JsonType::OBJECT;
+        position++;
+        skipWhitespace();
+        if(position < input.size() && input[position] == '}') {
+            position++;
+            return value;
+        }
+
+        while(true) {
+            skipWhitespace();
+            std::string name = readString();
+            expect(':');
+            value.members.push_back(std::make_pair(name, readValue()));
+
+            skipWhitespace();
+            if(position < input.size() && input[position] == ',') position++;
+            else {
+                expect('}');
+                return value;
+            }
+        }
+    }
+    else if(character == '[') {
+        value.type = JsonType::ARRAY;
+        position++;
+        skipWhitespace();
+        if(position < input.size() && input[position] == ']') {
+            position++;
+            return value;
+        }
+
+        while(true) {
+            value.items.push_back(readValue());
+
+            skipWhitespace();
+            if(position < input.size() && input[position] == ',') position++;
+            else {
+                expect(']');
+                return value;
+            }
+        }
+    }
+    else if(character == '"') {
+        value.type = JsonType::STRING;
+        value.text = readString();
+    }
+    else if(input.compare(position, 4, "true") == 0 || input.compare(position, 5, "false") == 0) {
+        value.type = JsonType::BOOLEAN;
+        value.boolean = character == 't';
+        position += value.boolean ? 4 : 5;
+    }
+    else if(input.compare(position, 4, "null") == 0) position += 4;
+    else {
+        value.type = JsonType::NUMBER;
+        std::from_chars_result result = std::from_chars(input.data() + position, input.data() + input.size(), value.number);
+        if(result.ec != std::errc()) error("unexpected character");
+        position = result.ptr - input.data();
+    }
+
+    return value;
+}
+
+// PUBLIC METHODS
+
+JsonValue JsonReader::parse(std::string_view text) {
+    JsonReader reader(text);
+    JsonValue value = reader.readValue();
+
+    reader.skipWhitespace();
+    if(reader.position != text.size()) reader.error("unexpected data after the value");
+    return value;
+}
+
+JsonValue JsonReader::parseFile(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if(!file) throw std::invalid_argument("Can't open JSON file: " + fileName);
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    try {
+        return parse(contents.str());
+    }
+    catch(const std::invalid_argument& e) {
+        throw std::invalid_argument(fileName + ": " + e.what());
+    }
+}
+
+const JsonValue& getJsonMember(const JsonValue& object, const std::string& name, JsonType type) {
+    if(object.type == JsonType::OBJECT) {
+        for(const std::pair<std::string, JsonValue>& member : object.members) {
+            if(member.first == name) {
+                if(member.second.type != type) throw std::invalid_argument("JSON member has the wrong type: " + name);
+                return member.second;
+            }
+        }
+    }
+
+    throw std::invalid_argument("Missing JSON member: " + name);
+}
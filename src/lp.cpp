@@ -1,4 +1,6 @@
 #include "lp.h"
+#include "scaling.h"
+#include "barrier.h"
 #include <cmath>
 #include <iostream>
 #include <iomanip>
@@ -9,25 +11,22 @@
 
 bool LpProblem::isSimplexDone(Matrix& cj_minus_zj) {
     for(int i = 0; i < cj_minus_zj.getNColumns(); i++) {
-        if(cj_minus_zj.getElement(0, i) > 0) return false;
+        if(cj_minus_zj.getElement(0, i) > SIMPLEX_EPSILON) return false;
     }
     return true;
 }
 
 unsigned LpProblem::getPivotRow(Matrix& simplexAux, Matrix& bAux, Matrix& ratios) {
-    double minValue = M;
-    unsigned minIndex = 0;
-    unsigned invalid = 0;
+    double minValue = INFINITY;
+    unsigned minIndex = -1;
     double ratioElement;
 
+    // only rows with a positive pivot element limit the entering variable(degenerate rows, with a zero ratio, included)
     for(int i = 0; i < ratios.getNRows(); i++) {
-        if(simplexAux.getElement(i, 0) <= 0) invalid++;
-    }
-    if(invalid == ratios.getNRows()) return -1;
+        if(simplexAux.getElement(i, 0) <= SIMPLEX_EPSILON) continue;
 
-    for(int i = 0; i < ratios.getNRows(); i++) {
-        ratioElement = ratios.getElement(i, 0);
-        if(ratioElement < minValue && ratioElement > 0 && ratioElement != M) {
+        ratioElement = bAux.getElement(i, 0) / simplexAux.getElement(i, 0);
+        if(ratioElement < minValue) {
             minValue = ratioElement;
             minIndex = i;
         }
@@ -290,6 +289,21 @@ std::vector<std::pair<int, int>> LpProblem::getConstraintsIndexes(Matrix extraCj
 }
 
 Matrix LpProblem::solveSimplex() {
+    // without constraints, each variable goes to 0 unless it improves the objective function, which makes the problem unbounded
+    if(constraints.empty()) {
+        lpIterations = 0;
+        for(uint i = 0; i < objectiveFunction.getNColumns(); i++) {
+            double coefficient = (type == MAX) ? objectiveFunction.getElement(0, i) : -objectiveFunction.getElement(0, i);
+            if(coefficient > 0) {
+                status = UNBOUNDED;
+                optimalSolution = Matrix({INFINITY}, 1, 1);
+                return optimalSolution;
+            }
+        }
+        optimalSolution = zeros(1, objectiveFunction.getNColumns());
+        return optimalSolution;
+    }
+
     std::pair<uint, uint> pivots = std::make_pair(0, 0);
     std::vector<Matrix> things = initialSimplexTableau();
     Matrix& simplexTableau = things[0];
@@ -317,10 +331,11 @@ Matrix LpProblem::solveSimplex() {
     }
     Matrix cj_minus_zj = cj - zj;
 
-    uint iterations = 0;
+    lpIterations = 0;
     Matrix ratios = zeros(constraints.size(), 1);
     Matrix pivotColumn;
     while(!isSimplexDone(cj_minus_zj)) {
+        if(isCancelled()) return optimalSolution;
 
         pivots.second = cj_minus_zj.maxValueIndex();
         ratios = zeros(constraints.size(), 1);
@@ -365,40 +380,25 @@ Matrix LpProblem::solveSimplex() {
         basisIndices.setElement(oldBasis, 0, newBasis);
         cb.setElement(oldBasis, 0, cj.getElement(0, newBasis));
 
-        //Matrix newRow = Matrix(simplexTableau.getRow(oldBasis), 1, simplexTableau.columns()) * (1 / simplexTableau.getElement(oldBasis, newBasis));
-        Matrix newRow = simplexTableau.getRow(oldBasis) * (1 / simplexTableau.getElement(oldBasis, newBasis));
-        b.setElement(oldBasis, 0, b.getElement(oldBasis, 0) / simplexTableau.getElement(oldBasis, newBasis));
-
-        simplexTableau = simplexTableau.setRow(oldBasis, newRow);
-
-        for(int i = 0; i < simplexTableau.getNRows(); i++) {
-            if(i == oldBasis) continue;
-            else {
-                double factor = simplexTableau.getElement(i, newBasis);
-                simplexTableau.rowOperation(oldBasis, i, -1 * factor);
-                b.rowOperation(oldBasis, i, -1 * factor);
-            }
-        }
-
-        for(int i = 0; i < simplexTableau.getNColumns(); i++) {
-            Matrix currentColumn = simplexTableau.getColumn(i);
-            double innerProduct = cb.dotProduct(currentColumn); 
-            zj.setElement(0, i, innerProduct);
-        }
+        pivotTableau(simplexTableau, b, cb, zj, oldBasis, newBasis);
         cj_minus_zj = cj - zj;
 
-        iterations++;
+        lpIterations++;
 
     }
 
     Matrix solution = zeros(1, objectiveFunction.getNColumns());
 
-    // check if problem is infeasible
+    // check if problem is infeasible: an artificial variable still in the basis above the round off degenerate pivots leave behind
+    double largestRhs = 0;
+    for(Constraint& constraint : constraints) largestRhs = std::max(largestRhs, std::fabs(constraint.getRhs()));
+    double infeasibilityTolerance = SIMPLEX_EPSILON * std::max(1.0, largestRhs);
+
     double currentBasisIndex;
     for(int k = 0; k < basisIndices.getNRows(); k++) {
         currentBasisIndex = basisIndices.getElement(k, 0);
         if(currentBasisIndex < objectiveFunction.getNColumns()) solution.setElement(0, currentBasisIndex, b.getElement(k, 0));
-        else if(currentBasisIndex >= objectiveFunction.getNColumns() + n_surplus_slack_variables && b.getElement(k, 0) > 0) {
+        else if(currentBasisIndex >= objectiveFunction.getNColumns() + n_surplus_slack_variables && b.getElement(k, 0) > infeasibilityTolerance) {
             status = INFEASIBLE;
             solution = Matrix({0}, 1, 1);
             break;
@@ -410,232 +410,100 @@ Matrix LpProblem::solveSimplex() {
     return solution;
 }
 
-bool LpProblem::canProblemBeSimplified(SimplifiedConstraintsHelper* helper) {
-    
-    checkForRepeatedConstraints(helper);
-
-    // Check if any variable's value can be fixed
-    canVariablesBeFixed(helper);
-    std::vector<uint> repeatedIndexes;
-    for(int i = 0; i < helper->constraintsToRemove.size(); i++) {
-        for(int j = 0; j < helper->constraintsToRemove.size(); j++) {
-            if(helper->constraintsToRemove[i] == helper->constraintsToRemove[j] && j > i) {
-                repeatedIndexes.push_back(j);
+Matrix LpProblem::solveBarrier(bool crossover) {
+    uint nVariables = objectiveFunction.getNColumns();
+
+    BarrierSolver barrier(*this);
+    uint barrierIterations = 0;
+    if(!constraints.empty()) {
+        ProblemStatus barrierStatus = barrier.solve();
+        barrierIterations = barrier.getIterations();
+
+        if(barrierStatus == CONTINUOUS_SOLUTION && !crossover) {
+            lpIterations = barrierIterations;
+            optimalSolution = Matrix(barrier.getSolution(), 1, nVariables);
+            return optimalSolution;
+        }
+        else if(barrierStatus == CONTINUOUS_SOLUTION) {
+            // the variables whose reduced cost is larger than their value are 0 at every optimal solution
+            std::vector<double> x = barrier.getSolution();
+            std::vector<double> reducedCosts = barrier.getReducedCosts();
+            std::vector<uint> optimalFace;
+            for(uint j = 0; j < nVariables; j++) {
+                if(x[j] >= reducedCosts[j]) optimalFace.push_back(j);
             }
-        }
-    }
-
-    std::sort(repeatedIndexes.begin(), repeatedIndexes.end(), std::greater<unsigned>());
-    for(int i: repeatedIndexes) {
-        helper->constraintsToRemove.erase(helper->constraintsToRemove.begin() + i);
-    }
-    std::sort(helper->constraintsToRemove.begin(), helper->constraintsToRemove.end(), std::greater<unsigned>());
 
-    removeRepeatedFixedVariablesPairs(helper);
+            std::vector<double> faceObjective;
+            for(uint j : optimalFace) faceObjective.push_back(objectiveFunction.getElement(0, j));
 
-    if(helper->constraintsToRemove.size() == 0 && helper->fixedVariables.size() == 0) return false;
-
-    return true;
-}
-
-bool LpProblem::simplifyProblem(SimplifiedConstraintsHelper* helper) {
-    removeConstraints(helper);
-
-    // para variaveis fixadas, eliminar essas variaveis e usar o modelo "oldVariablesToNewVariables"
-
-    checkForRepeatedConstraints(helper);
-
-    canVariablesBeFixed(helper);
-
-    newVarsToOldVars(helper);
-
-    std::vector<uint> repeatedIndexes;
-    for(uint i = 0; i < helper->constraintsToRemove.size(); i++) {
-        for(uint j = 0; j < helper->constraintsToRemove.size(); j++) {
-            if(helper->constraintsToRemove[i] == helper->constraintsToRemove[j] && j > i) {
-                repeatedIndexes.push_back(j);
+            std::vector<Constraint> faceConstraints;
+            for(Constraint& currentConstraint : constraints) {
+                std::vector<double> faceLhs;
+                for(uint j : optimalFace) faceLhs.push_back(currentConstraint.getLhs()[j]);
+                faceConstraints.push_back(currentConstraint);
+                faceConstraints.back().getLhs() = faceLhs;
             }
-        }
-    }
-
-    std::sort(repeatedIndexes.begin(), repeatedIndexes.end(), std::greater<unsigned>());
-    for(uint i: repeatedIndexes) {
-        helper->constraintsToRemove.erase(helper->constraintsToRemove.begin() + i);
-    }
-    std::sort(helper->constraintsToRemove.begin(), helper->constraintsToRemove.end(), std::greater<unsigned>());
-
-    removeFixedVariables(helper);
-
-    return true;
-}
 
-void LpProblem::simplifiedProblemSolution(SimplifiedConstraintsHelper* helper,  Matrix& simplifiedSolution) {
-
-    Matrix unboundedSol = Matrix({INFINITY}, 1, 1);
-    Matrix infeasibleSol = Matrix({0}, 1, 1);
-
-    if(simplifiedSolution == infeasibleSol) {
-        status = INFEASIBLE;
-        optimalSolution = infeasibleSol;
-        return;
-    }
-    else if(simplifiedSolution == unboundedSol) {
-        status = UNBOUNDED;
-        optimalSolution = unboundedSol;
-        return;
-    }
-
-    Matrix actualSolution = zeros(1, simplifiedSolution.getNColumns() + helper->fixedVariables.size());
-
-    for(const std::pair<uint, uint>& pairsOfVars : helper->pairsOfVars) {
-        actualSolution.setElement(0, pairsOfVars.second, simplifiedSolution.getElement(0, pairsOfVars.first));
-    }
-
-    for(const std::pair<uint, double>& fixedVars : helper->fixedVariables) {
-        actualSolution.setElement(0, fixedVars.first, fixedVars.second);
-    }
-
-    optimalSolution = actualSolution;
-}
-
-void LpProblem::canVariablesBeFixed(SimplifiedConstraintsHelper* helper) {
-    uint n_vars = objectiveFunction.getNColumns();
-    std::vector<std::pair<uint, uint>> basisConstraintsInfo; // .first is the constraint index, .second is the index i in xi <=/=/>= k
-    
-    // store information of all constraints of the form xi <=/=/>= k in basisConstraintsInfo
-    for(int i = 0; i < constraints.size(); i++) {
-        int basisVarIndex = isBasisVector(constraints[i].getLhs());
-        if(basisVarIndex != -1) basisConstraintsInfo.emplace_back(i, basisVarIndex);
-    }
-
-    for(int i = 0; i < basisConstraintsInfo.size(); i++) {
-        int currentBasisConstraint_i = basisConstraintsInfo[i].first;
-
-        // Check for constraints of the form xi = k, where i = 1,...,n and k is a real number
-        if(constraints[currentBasisConstraint_i].getType() == EQUAL) {
-            helper->constraintsToRemove.push_back(currentBasisConstraint_i);
-            helper->fixedVariables.push_back(std::make_pair(basisConstraintsInfo[currentBasisConstraint_i].second, constraints[currentBasisConstraint_i].getRhs()));
-            //helper->fixedVariables.emplace_back(basisConstraintsInfo[currentBasisConstraint_i].second, constraints[currentBasisConstraint_i].getRhs());
-        }
-
-        // checks for any constraint of the types xi <= k and xi >= k   
-        for(int j = i + 1; j < basisConstraintsInfo.size(); j++) {
-            int currentBasisConstraint_j = basisConstraintsInfo[j].first;
-            if(constraints[currentBasisConstraint_i].getLhs() == constraints[currentBasisConstraint_j].getLhs() &&
-               constraints[currentBasisConstraint_i].getType() != constraints[currentBasisConstraint_j].getType() &&
-               constraints[currentBasisConstraint_i].getRhs() == constraints[currentBasisConstraint_j].getRhs() &&
-               (constraints[currentBasisConstraint_i].getType() != EQUAL && constraints[currentBasisConstraint_j].getType() != EQUAL)) {
-                    helper->fixedVariables.push_back({basisConstraintsInfo[i].second, constraints[currentBasisConstraint_i].getRhs()});
-                    //helper->fixedVariables.emplace_back(basisConstraintsInfo[i].second, constraints[currentBasisConstraint_i].getRhs());
-                    helper->constraintsToRemove.push_back(currentBasisConstraint_i);
-                    helper->constraintsToRemove.push_back(currentBasisConstraint_j);
+            if(!optimalFace.empty()) {
+                LpProblem faceProblem(type, faceObjective, faceConstraints);
+                faceProblem.setCancelFlag(cancelFlag);
+                faceProblem.solveSimplex();
+
+                Matrix solution = zeros(1, nVariables);
+                if(faceProblem.status != INFEASIBLE && faceProblem.status != UNBOUNDED) {
+                    for(uint k = 0; k < optimalFace.size(); k++) solution.setElement(0, optimalFace[k], faceProblem.optimalSolution.getElement(0, k));
+                }
+
+                // a variable misclassified as 0 makes the face's optimum worse than the barrier's, which would be a wrong bound for the tree
+                double barrierObjective = Matrix(x, 1, nVariables).dotProduct(objectiveFunction);
+                double faceObjective = solution.dotProduct(objectiveFunction);
+                if(faceProblem.status != INFEASIBLE && faceProblem.status != UNBOUNDED &&
+                   std::fabs(faceObjective - barrierObjective) <= BARRIER_CROSSOVER_TOLERANCE * std::max(1.0, std::fabs(barrierObjective))) {
+                    lpIterations = barrierIterations + faceProblem.lpIterations;
+                    optimalSolution = solution;
+                    return optimalSolution;
+                }
+                barrierIterations += faceProblem.lpIterations;
             }
         }
-
-        // Check for constraints of the form xi <= 0
-        if(constraints[currentBasisConstraint_i].getType() == LESS_THAN_OR_EQUAL && constraints[currentBasisConstraint_i].getRhs() == 0) {
-            helper->fixedVariables.push_back({basisConstraintsInfo[i].second, 0});
-            //helper->fixedVariables.emplace_back(basisConstraintsInfo[i].second, 0);
-            helper->constraintsToRemove.push_back(currentBasisConstraint_i);
-        }
     }
 
-    // remove repeated fixed variables
-    std::vector<uint> repeatedIndexes;
-    for(int i = 0; i < helper->fixedVariables.size(); i++) {
-        for(int j = i + 1; j < helper->fixedVariables.size(); j++) {
-            if(helper->fixedVariables[i] == helper->fixedVariables[j]) {
-                repeatedIndexes.push_back(j);
-                //std::cout << j << " ";
-            }
-        }
-    }
-    //std::cout << std::endl;
+    if(isCancelled()) return optimalSolution;
 
-    if(repeatedIndexes.size() > 0) {
-        std::sort(repeatedIndexes.begin(), repeatedIndexes.end(), std::greater<unsigned>());
-        for(uint i : repeatedIndexes) {
-            helper->fixedVariables.erase(helper->fixedVariables.begin() + i);
-        }
-    }
-
-    std::sort(helper->fixedVariables.begin(), helper->fixedVariables.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
-}
-
-void LpProblem::checkForRepeatedConstraints(SimplifiedConstraintsHelper* helper) {
-    // Check for repeated constraints
-    for(int i = 0; i < constraints.size(); i++) {
-        for(int j = i + 1; j < constraints.size(); j++) {
-            if(constraints[i] == constraints[j])
-                helper->constraintsToRemove.push_back(j);
-        }
-    }
+    // barrier didn't converge(or crossover failed, or didn't reach the barrier's objective function value), so the simplex method decides the problem
+    solveSimplex();
+    lpIterations += barrierIterations;
+    return optimalSolution;
 }
 
-void LpProblem::removeRepeatedFixedVariablesPairs(SimplifiedConstraintsHelper* helper) {
-    std::vector<uint> repeatedIndexes;
-    for(int i = 0; i < helper->fixedVariables.size(); i++) {
-        for(int j = i + 1; j < helper->fixedVariables.size(); j++) {
-            if(helper->fixedVariables[i] == helper->fixedVariables[j]) {
-                repeatedIndexes.push_back(j);
-            }
-        }
-    }
-
-    std::sort(repeatedIndexes.begin(), repeatedIndexes.end(), std::greater<unsigned>());
-
-    for(uint k : repeatedIndexes) {
-        helper->fixedVariables.erase(helper->fixedVariables.begin() + k);
+bool LpProblem::hasVariableBounds() {
+    for(uint i = 0; i < lowerBounds.size(); i++) {
+        if(lowerBounds[i] != 0 || !std::isinf(upperBounds[i])) return true;
     }
+    return false;
 }
 
-void LpProblem::newVarsToOldVars(SimplifiedConstraintsHelper* helper) {
-    std::vector<uint> fixedVars;
-    for(std::pair<uint, double>& k : helper->fixedVariables) {
-        fixedVars.push_back(k.first);
-    }
-
-    std::vector<std::pair<uint, uint>> pairsOfVars;
-    
-    std::vector<uint> freeVars;
-    for(uint i = 0; i < objectiveFunction.getNColumns(); i++) {
-        if(std::find(fixedVars.begin(), fixedVars.end(), i) == fixedVars.end()) {
-            freeVars.push_back(i);
-        }
-    }
-
-    for(uint i = 0; i < freeVars.size(); i++) {
-        //pairsOfVars.push_back(std::make_pair(i, freeVars[i]));
-        pairsOfVars.emplace_back(i, freeVars[i]);
-    }
+LpProblem LpProblem::boundsAsConstraints() {
+    uint nVariables = objectiveFunction.getNColumns();
+    std::vector<Constraint> shiftedConstraints = constraints;
 
-    helper->pairsOfVars = pairsOfVars;
-}
+    for(Constraint& currentConstraint : shiftedConstraints) {
+        std::vector<double>& lhs = currentConstraint.getLhs();
+        double shift = 0;
+        for(uint j = 0; j < nVariables; j++) shift += lhs[j] * lowerBounds[j];
 
-void LpProblem::removeConstraints(SimplifiedConstraintsHelper* helper) {
-    for(uint i : helper->constraintsToRemove) {
-        removeConstraint(i);
+        currentConstraint.setRhs(currentConstraint.getRhs() - shift);
+        currentConstraint.normalizeRhs();
     }
-}
 
-void LpProblem::removeOneFixedVariable(int varIndex, double fixedVarValue) {
-    if(varIndex < 0 || varIndex >= objectiveFunction.getNColumns()) {
-        std::ostringstream errorMsg;
-        errorMsg << "The LP model has " << objectiveFunction.getNColumns() << " variables, but the user tried to remove the variable with index " << varIndex;
-        throw std::invalid_argument(errorMsg.str());
+    for(uint j = 0; j < nVariables; j++) {
+        if(std::isinf(upperBounds[j])) continue;
+        std::vector<double> lhs(nVariables, 0.0);
+        lhs[j] = 1;
+        shiftedConstraints.push_back(Constraint(lhs, "<=", upperBounds[j] - lowerBounds[j]));
     }
 
-    objectiveFunction.removeColumn(varIndex);
-
-    for(uint i = 0; i < constraints.size(); i++) {
-        constraints[i].removeFixedVariable(varIndex, fixedVarValue);
-    }
-}
-
-void LpProblem::removeFixedVariables(SimplifiedConstraintsHelper* helper) {
-    for(std::pair<uint, double>& fixedVars : helper->fixedVariables) {
-        removeOneFixedVariable(fixedVars.first, fixedVars.second);
-    }
+    return LpProblem(type, objectiveFunction.getElements(), shiftedConstraints);
 }
 
 // PUBLIC METHODS
@@ -643,7 +511,16 @@ void LpProblem::removeFixedVariables(SimplifiedConstraintsHelper* helper) {
 LpProblem::LpProblem(ProblemType modelType, std::vector<double> newObjectiveFunction, std::vector<Constraint> newConstraints) {
     type = modelType;
     objectiveFunction = Matrix(newObjectiveFunction, 1, newObjectiveFunction.size());
-    constraints = newConstraints;
+    objectiveOffset = 0;
+    constraints = std::move(newConstraints);
+    lowerBounds = std::vector<double>(objectiveFunction.getNColumns(), 0.0);
+    upperBounds = std::vector<double>(objectiveFunction.getNColumns(), INFINITY);
+    scalingEnabled = true;
+    algorithm = SIMPLEX;
+    crossoverEnabled = true;
+    lpIterations = 0;
+    cancelFlag = NULL;
+    lastScalingQuality = std::make_pair(1.0, 1.0);
     status = NOT_YET_SOLVED;
     optimalSolution = zeros(1, objectiveFunction.getNColumns());
 }
@@ -651,7 +528,16 @@ LpProblem::LpProblem(ProblemType modelType, std::vector<double> newObjectiveFunc
 LpProblem::LpProblem(const LpProblem& problem) {
     type = problem.type;
     objectiveFunction = problem.objectiveFunction;
+    objectiveOffset = problem.objectiveOffset;
     constraints = problem.constraints;
+    lowerBounds = problem.lowerBounds;
+    upperBounds = problem.upperBounds;
+    scalingEnabled = problem.scalingEnabled;
+    algorithm = problem.algorithm;
+    crossoverEnabled = problem.crossoverEnabled;
+    lpIterations = problem.lpIterations;
+    cancelFlag = problem.cancelFlag;
+    lastScalingQuality = problem.lastScalingQuality;
     optimalSolution = problem.optimalSolution;
     status = problem.status;
 }
@@ -660,13 +546,45 @@ LpProblem& LpProblem::operator=(const LpProblem& otherProblem) {
     if(this != &otherProblem) {
         type = otherProblem.type;
         objectiveFunction = otherProblem.objectiveFunction;
+        objectiveOffset = otherProblem.objectiveOffset;
         constraints = otherProblem.constraints;
+        lowerBounds = otherProblem.lowerBounds;
+        upperBounds = otherProblem.upperBounds;
+        scalingEnabled = otherProblem.scalingEnabled;
+        algorithm = otherProblem.algorithm;
+        crossoverEnabled = otherProblem.crossoverEnabled;
+        lpIterations = otherProblem.lpIterations;
+        cancelFlag = otherProblem.cancelFlag;
+        lastScalingQuality = otherProblem.lastScalingQuality;
         optimalSolution = otherProblem.optimalSolution;
         status = otherProblem.status;
     }
     return *this;
 }
 
+void LpProblem::pivotTableau(Matrix& simplexTableau, Matrix& b, Matrix& cb, Matrix& zj, uint pivotRow, uint pivotColumn) {
+    //Matrix newRow = Matrix(simplexTableau.getRow(pivotRow), 1, simplexTableau.columns()) * (1 / simplexTableau.getElement(pivotRow, pivotColumn));
+    Matrix newRow = simplexTableau.getRow(pivotRow) * (1 / simplexTableau.getElement(pivotRow, pivotColumn));
+    b.setElement(pivotRow, 0, b.getElement(pivotRow, 0) / simplexTableau.getElement(pivotRow, pivotColumn));
+
+    simplexTableau = simplexTableau.setRow(pivotRow, newRow);
+
+    for(uint i = 0; i < simplexTableau.getNRows(); i++) {
+        if(i == pivotRow) continue;
+        else {
+            double factor = simplexTableau.getElement(i, pivotColumn);
+            simplexTableau.rowOperation(pivotRow, i, -1 * factor);
+            b.rowOperation(pivotRow, i, -1 * factor);
+        }
+    }
+
+    for(uint i = 0; i < simplexTableau.getNColumns(); i++) {
+        Matrix currentColumn = simplexTableau.getColumn(i);
+        double innerProduct = cb.dotProduct(currentColumn); 
+        zj.setElement(0, i, innerProduct);
+    }
+}
+
 void LpProblem::displaySimplexTableau(Matrix tableau, Matrix cb, Matrix basisIndexes, Matrix cj, Matrix b, Matrix zj, Matrix cj_minus_zj) {
     /*
     Matrix extraCj = cj.subMatrix(0, 0, objectiveFunction.columns(), cj.columns() - 1);
@@ -884,9 +802,9 @@ void LpProblem::displayProblem() {
             if(i < optimalSolution.getNColumns() - 1) std::cout << ", ";
         }
         std::cout << "), and Z = ";
-        if(floor(optimalSolution.dotProduct(objectiveFunction)) == optimalSolution.dotProduct(objectiveFunction)) 
-            std::cout << unsigned(optimalSolution.dotProduct(objectiveFunction)) << std::endl;
-        else std::cout << std::setprecision(3) << std::fixed << optimalSolution.dotProduct(objectiveFunction) << std::endl;
+        double value = optimalSolution.dotProduct(objectiveFunction) + objectiveOffset;
+        if(floor(value) == value) std::cout << (long long)value << std::endl;
+        else std::cout << std::setprecision(3) << std::fixed << value << std::endl;
     }
 }
 
@@ -905,29 +823,101 @@ void LpProblem::removeConstraint(int constraintIndex) {
 }
 
 void LpProblem::solveProblem() {
-    SimplifiedConstraintsHelper helper;
+    // the bounds of the problem were found to be contradictory, when they were last tightened
+    if(status == INFEASIBLE) {
+        optimalSolution = Matrix({0}, 1, 1);
+        lpIterations = 0;
+        return;
+    }
 
-    if(canProblemBeSimplified(&helper)) {
-        if(helper.fixedVariables.size() == objectiveFunction.getNColumns()) {
-	        optimalSolution = zeros(1, objectiveFunction.getNColumns());
-            for(std::pair<uint, double> fixedVars: helper.fixedVariables) {
-                optimalSolution.setElement(0, fixedVars.first, fixedVars.second);
-            }
+    if(!hasVariableBounds() && !scalingEnabled && algorithm == SIMPLEX) {
+        solveSimplex();
+    }
+    else {
+        LpProblem simplexProblem = hasVariableBounds() ? boundsAsConstraints() : LpProblem(type, objectiveFunction.getElements(), constraints);
+
+        simplexProblem.setCancelFlag(cancelFlag);
+
+        ScalingFactors factors;
+        if(scalingEnabled) {
+            factors = computeScalingFactors(simplexProblem);
+            applyScaling(simplexProblem, factors);
+            lastScalingQuality = std::make_pair(factors.qualityBefore, factors.qualityAfter);
         }
+
+        if(algorithm == BARRIER) simplexProblem.solveBarrier(crossoverEnabled);
+        else simplexProblem.solveSimplex();
+        lpIterations = simplexProblem.lpIterations;
+
+        if(simplexProblem.status == INFEASIBLE) optimalSolution = Matrix({0}, 1, 1);
+        else if(simplexProblem.status == UNBOUNDED) optimalSolution = Matrix({INFINITY}, 1, 1);
         else {
-            LpProblem auxProblem(type, objectiveFunction.getElements(), constraints);
-            auxProblem.simplifyProblem(&helper);
-            auxProblem.solveSimplex();
-            simplifiedProblemSolution(&helper, auxProblem.getOptimalSolution());
+            optimalSolution = simplexProblem.getOptimalSolution();
+            if(scalingEnabled) unscaleSolution(optimalSolution, factors);
+            for(uint i = 0; i < optimalSolution.getNColumns(); i++) {
+                optimalSolution.setElement(0, i, optimalSolution.getElement(0, i) + lowerBounds[i]);
+            }
         }
     }
-    else {
-        solveSimplex();
-    }
 
     isOptimalSolutionWhole();
 }
 
+void LpProblem::setVariableBounds(uint varIndex, double lower, double upper) {
+    if(varIndex >= objectiveFunction.getNColumns()) {
+        std::ostringstream errorMsg;
+        errorMsg << "The LP model has " << objectiveFunction.getNColumns() << " variables, but the user tried to set the bounds of the variable with index " << varIndex;
+        throw std::invalid_argument(errorMsg.str());
+    }
+
+    lowerBounds[varIndex] = lower;
+    upperBounds[varIndex] = upper;
+}
+
+void LpProblem::tightenVariableBounds(uint varIndex, double lower, double upper) {
+    if(varIndex >= objectiveFunction.getNColumns()) {
+        std::ostringstream errorMsg;
+        errorMsg << "The LP model has " << objectiveFunction.getNColumns() << " variables, but the user tried to tighten the bounds of the variable with index " << varIndex;
+        throw std::invalid_argument(errorMsg.str());
+    }
+
+    status = NOT_YET_SOLVED;
+    lowerBounds[varIndex] = std::max(lowerBounds[varIndex], lower);
+    upperBounds[varIndex] = std::min(upperBounds[varIndex], upper);
+
+    if(lowerBounds[varIndex] > upperBounds[varIndex] + SIMPLEX_EPSILON) {
+        status = INFEASIBLE;
+        return;
+    }
+
+    // only the constraints which contain the variable can have become infeasible
+    for(Constraint& currentConstraint : constraints) {
+        std::vector<double>& lhs = currentConstraint.getLhs();
+        if(lhs[varIndex] == 0) continue;
+
+        double minActivity = 0, maxActivity = 0;
+        for(uint j = 0; j < lhs.size(); j++) {
+            if(lhs[j] > 0) {
+                minActivity += lhs[j] * lowerBounds[j];
+                maxActivity += lhs[j] * upperBounds[j];
+            }
+            else if(lhs[j] < 0) {
+                minActivity += lhs[j] * upperBounds[j];
+                maxActivity += lhs[j] * lowerBounds[j];
+            }
+        }
+
+        double rhs = currentConstraint.getRhs();
+        ConstraintType constraintType = currentConstraint.getType();
+        double tolerance = SIMPLEX_EPSILON * std::max(1.0, std::fabs(rhs));
+        if((constraintType != GREATER_THAN_OR_EQUAL && minActivity > rhs + tolerance) ||
+           (constraintType != LESS_THAN_OR_EQUAL && maxActivity < rhs - tolerance)) {
+            status = INFEASIBLE;
+            return;
+        }
+    }
+}
+
 bool LpProblem::isOptimalSolutionWhole() {
     Matrix infeasibleSol({0}, 1, 1);
     Matrix unboundedSol({INFINITY}, 1, 1);
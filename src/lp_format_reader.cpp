@@ -0,0 +1,324 @@
+#include "lp_format_reader.h"
+
+#include <sstream>
+#include <cmath>
+#include <cctype>
+
+#define LP_FORMAT_INFINITY 1e30
+
+namespace {
+
+bool equalsIgnoreCase(std::string_view text, std::string_view keyword) {
+    if(text.size() != keyword.size()) return false;
+    for(size_t i = 0; i < text.size(); i++) {
+        if(std::tolower((unsigned char)text[i]) != keyword[i]) return false;
+    }
+    return true;
+}
+
+bool isRelation(TokenType type) {
+    return type == TokenType::LESS_EQUAL || type == TokenType::GREATER_EQUAL || type == TokenType::EQUAL;
+}
+
+}
+
+// PRIVATE METHODS
+
+LpFormatReader::LpFormatReader(std::string_view text) : tokenizer(text) {
+    model = emptySparseModel();
+    triplets = emptyTripletBuffer();
+}
+
+const Token& LpFormatReader::peek() {
+    while(tokenizer.peek().type == TokenType::NEWLINE) tokenizer.next();
+    return tokenizer.peek();
+}
+
+Token LpFormatReader::next() {
+    peek();
+    return tokenizer.next();
+}
+
+void LpFormatReader::fail(const Token& token, const std::string& message) {
+    std::ostringstream errorMsg;
+    errorMsg << "LP line " << token.line << ": " << message;
+    throw std::invalid_argument(errorMsg.str());
+}
+
+LpSection LpFormatReader::readSectionKeyword(bool consume) {
+    const Token& token = peek();
+    if(token.type != TokenType::IDENTIFIER) return LpSection::OBJECTIVE;
+
+    std::string_view word = token.text;
+    LpSection section;
+    std::string_view secondWord;
+
+    if(equalsIgnoreCase(word, "subject")) {
+        section = LpSection::CONSTRAINTS;
+        secondWord = "to";
+    }
+    else if(equalsIgnoreCase(word, "such")) {
+        section = LpSection::CONSTRAINTS;
+        secondWord = "that";
+    }
+    else if(equalsIgnoreCase(word, "st") || equalsIgnoreCase(word, "s.t.") || equalsIgnoreCase(word, "st.")) section = LpSection::CONSTRAINTS;
+    else if(equalsIgnoreCase(word, "bounds") || equalsIgnoreCase(word, "bound")) section = LpSection::BOUNDS;
+    else if(equalsIgnoreCase(word, "general") || equalsIgnoreCase(word, "generals") || equalsIgnoreCase(word, "gen") ||
+            equalsIgnoreCase(word, "integer") || equalsIgnoreCase(word, "integers") || equalsIgnoreCase(word, "int")) section = LpSection::GENERAL;
+    else if(equalsIgnoreCase(word, "binary") || equalsIgnoreCase(word, "binaries") || equalsIgnoreCase(word, "bin")) section = LpSection::BINARY;
+    else if(equalsIgnoreCase(word, "end")) section = LpSection::END;
+    else if(equalsIgnoreCase(word, "semi") || equalsIgnoreCase(word, "semis") || equalsIgnoreCase(word, "sos")) {
+        fail(token, "semi-continuous variables and SOS constraints aren't supported");
+    }
+    else return LpSection::OBJECTIVE;
+
+    if(consume) {
+        Token keyword = next();
+        if(!secondWord.empty()) {
+            Token second = next();
+            if(second.type != TokenType::IDENTIFIER || !equalsIgnoreCase(second.text, secondWord)) {
+                fail(second, "expected '" + std::string(secondWord) + "' after '" + std::string(keyword.text) + "'");
+            }
+        }
+    }
+    return section;
+}
+
+uint LpFormatReader::getColumn(std::string_view name) {
+    std::unordered_map<std::string_view, uint>::iterator column = columnIndexes.find(name);
+    if(column != columnIndexes.end()) return column->second;
+
+    uint index = model.columnNames.size();
+    columnIndexes[name] = index;
+    model.columnNames.push_back(std::string(name));
+    model.objective.push_back(0);
+    model.lowerBounds.push_back(0);
+    model.upperBounds.push_back(INFINITY);
+    model.integer.push_back(false);
+    return index;
+}
+
+bool LpFormatReader::isValueStart() {
+    const Token& token = peek();
+    if(token.type == TokenType::PLUS || token.type == TokenType::MINUS || token.type == TokenType::NUMBER) return true;
+    return token.type == TokenType::IDENTIFIER && (equalsIgnoreCase(token.text, "inf") || equalsIgnoreCase(token.text, "infinity"));
+}
+
+double LpFormatReader::readValue() {
+    double sign = 1;
+    while(peek().type == TokenType::PLUS || peek().type == TokenType::MINUS) {
+        if(next().type == TokenType::MINUS) sign = -sign;
+    }
+
+    Token token = next();
+    if(token.type == TokenType::NUMBER) return (token.value >= LP_FORMAT_INFINITY) ? sign * INFINITY : sign * token.value;
+    if(token.type == TokenType::IDENTIFIER && (equalsIgnoreCase(token.text, "inf") || equalsIgnoreCase(token.text, "infinity"))) return sign * INFINITY;
+    fail(token, "expected a number");
+}
+
+void LpFormatReader::readExpression(std::vector<std::pair<uint, double>>& terms, double& constant, std::string_view firstVariable) {
+    terms.clear();
+    constant = 0;
+    bool first = true;
+
+    if(!firstVariable.empty()) {
+        terms.emplace_back(getColumn(firstVariable), 1.0);
+        first = false;
+    }
+
+    while(true) {
+        TokenType type = peek().type;
+        bool signedTerm = (type == TokenType::PLUS || type == TokenType::MINUS);
+        if(!signedTerm && !(first && (type == TokenType::NUMBER || type == TokenType::IDENTIFIER))) return;
+        if(type == TokenType::IDENTIFIER && readSectionKeyword(false) != LpSection::OBJECTIVE) return;
+
+        double coefficient = 1;
+        while(peek().type == TokenType::PLUS || peek().type == TokenType::MINUS) {
+            if(next().type == TokenType::MINUS) coefficient = -coefficient;
+        }
+
+        bool hasNumber = false;
+        if(peek().type == TokenType::NUMBER) {
+            coefficient *= next().value;
+            hasNumber = true;
+        }
+
+        if(peek().type == TokenType::IDENTIFIER && readSectionKeyword(false) == LpSection::OBJECTIVE) {
+            terms.emplace_back(getColumn(next().text), coefficient);
+        }
+        else if(hasNumber) constant += coefficient;
+        else fail(peek(), "expected a term after the sign");
+
+        first = false;
+    }
+}
+
+std::string_view LpFormatReader::readLabel(std::string& label) {
+    label.clear();
+    if(peek().type != TokenType::IDENTIFIER || readSectionKeyword(false) != LpSection::OBJECTIVE) return std::string_view();
+
+    Token name = next();
+    if(peek().type == TokenType::COLON) {
+        next();
+        label = std::string(name.text);
+        return std::string_view();
+    }
+    return name.text;
+}
+
+void LpFormatReader::readObjective() {
+    Token sense = next();
+    if(sense.type == TokenType::IDENTIFIER && (equalsIgnoreCase(sense.text, "maximize") || equalsIgnoreCase(sense.text, "maximise") ||
+                                               equalsIgnoreCase(sense.text, "maximum") || equalsIgnoreCase(sense.text, "max"))) {
+        model.type = MAX;
+    }
+    else if(sense.type == TokenType::IDENTIFIER && (equalsIgnoreCase(sense.text, "minimize") || equalsIgnoreCase(sense.text, "minimise") ||
+                                                    equalsIgnoreCase(sense.text, "minimum") || equalsIgnoreCase(sense.text, "min"))) {
+        model.type = MIN;
+    }
+    else fail(sense, "the model must start with Maximize or Minimize");
+
+    std::string label;
+    std::string_view firstVariable = readLabel(label);
+
+    std::vector<std::pair<uint, double>> terms;
+    double constant;
+    readExpression(terms, constant, firstVariable);
+
+    for(const std::pair<uint, double>& term : terms) model.objective[term.first] += term.second;
+    model.objectiveOffset = constant;
+}
+
+void LpFormatReader::readConstraint() {
+    std::string label;
+    std::string_view firstVariable = readLabel(label);
+
+    std::vector<std::pair<uint, double>> terms;
+    double constant;
+    readExpression(terms, constant, firstVariable);
+
+    Token relation = next();
+    if(!isRelation(relation.type)) fail(relation, "expected <=, >= or = in constraint");
+
+    ConstraintType type;
+    double rhs, range = NAN;
+
+    if(terms.empty()) {
+        // the constant is on the left: constant <= expression [<= upper]
+        double lower = constant;
+        readExpression(terms, constant, std::string_view());
+        if(terms.empty()) fail(relation, "constraint without variables");
+
+        if(isRelation(peek().type)) {
+            Token secondRelation = next();
+            if(secondRelation.type != relation.type || relation.type == TokenType::EQUAL) fail(secondRelation, "invalid ranged constraint");
+            double upper = readValue() - constant;
+            lower -= constant;
+            if(relation.type == TokenType::GREATER_EQUAL) std::swap(lower, upper);
+
+            type = (lower == upper) ? EQUAL : GREATER_THAN_OR_EQUAL;
+            rhs = lower;
+            if(lower != upper) range = upper - lower;
+        }
+        else {
+            rhs = lower - constant;
+            type = (relation.type == TokenType::LESS_EQUAL) ? GREATER_THAN_OR_EQUAL : (relation.type == TokenType::GREATER_EQUAL) ? LESS_THAN_OR_EQUAL : EQUAL;
+        }
+    }
+    else {
+        rhs = readValue() - constant;
+        type = (relation.type == TokenType::LESS_EQUAL) ? LESS_THAN_OR_EQUAL : (relation.type == TokenType::GREATER_EQUAL) ? GREATER_THAN_OR_EQUAL : EQUAL;
+    }
+
+    uint row = model.rowNames.size();
+    model.rowNames.push_back(label.empty() ? "c" + std::to_string(row + 1) : label);
+    model.rowTypes.push_back(type);
+    model.rhs.push_back(rhs);
+    model.ranges.push_back(range);
+
+    for(const std::pair<uint, double>& term : terms) {
+        triplets.rows.push_back(row);
+        triplets.columns.push_back(term.first);
+        triplets.values.push_back(term.second);
+    }
+}
+
+void LpFormatReader::readBound() {
+    // value relation variable [relation value]
+    if(isValueStart()) {
+        double value = readValue();
+        Token relation = next();
+        if(!isRelation(relation.type)) fail(relation, "expected <=, >= or = in bound");
+
+        Token variable = next();
+        if(variable.type != TokenType::IDENTIFIER) fail(variable, "expected a variable in bound");
+        uint column = getColumn(variable.text);
+
+        if(relation.type == TokenType::LESS_EQUAL) model.lowerBounds[column] = value;
+        else if(relation.type == TokenType::GREATER_EQUAL) model.upperBounds[column] = value;
+        else model.lowerBounds[column] = model.upperBounds[column] = value;
+
+        if(isRelation(peek().type)) {
+            Token secondRelation = next();
+            if(secondRelation.type != relation.type || relation.type == TokenType::EQUAL) fail(secondRelation, "invalid double bound");
+            double secondValue = readValue();
+            if(relation.type == TokenType::LESS_EQUAL) model.upperBounds[column] = secondValue;
+            else model.lowerBounds[column] = secondValue;
+        }
+        return;
+    }
+
+    // variable relation value, or variable free
+    Token variable = next();
+    if(variable.type != TokenType::IDENTIFIER) fail(variable, "expected a variable in bound");
+    uint column = getColumn(variable.text);
+
+    if(peek().type == TokenType::IDENTIFIER && equalsIgnoreCase(peek().text, "free")) {
+        next();
+        model.lowerBounds[column] = -INFINITY;
+        model.upperBounds[column] = INFINITY;
+        return;
+    }
+
+    Token relation = next();
+    if(!isRelation(relation.type)) fail(relation, "expected <=, >=, = or free in bound");
+    double value = readValue();
+
+    if(relation.type == TokenType::LESS_EQUAL) model.upperBounds[column] = value;
+    else if(relation.type == TokenType::GREATER_EQUAL) model.lowerBounds[column] = value;
+    else model.lowerBounds[column] = model.upperBounds[column] = value;
+}
+
+// PUBLIC METHODS
+
+SparseModel LpFormatReader::parse(std::string_view text) {
+    LpFormatReader reader(text);
+    reader.readObjective();
+
+    LpSection section = LpSection::OBJECTIVE;
+    while(reader.peek().type != TokenType::END_OF_INPUT && section != LpSection::END) {
+        LpSection keyword = reader.readSectionKeyword(true);
+        if(keyword != LpSection::OBJECTIVE) {
+            section = keyword;
+            continue;
+        }
+
+        if(section == LpSection::CONSTRAINTS) reader.readConstraint();
+        else if(section == LpSection::BOUNDS) reader.readBound();
+        else if(section == LpSection::GENERAL || section == LpSection::BINARY) {
+            Token variable = reader.next();
+            if(variable.type != TokenType::IDENTIFIER) reader.fail(variable, "expected a variable name");
+
+            uint column = reader.getColumn(variable.text);
+            reader.model.integer[column] = true;
+            if(section == LpSection::BINARY) {
+                reader.model.lowerBounds[column] = 0;
+                reader.model.upperBounds[column] = 1;
+            }
+        }
+        else reader.fail(reader.peek(), "unexpected " + std::string(reader.peek().text) + " after the objective function");
+    }
+
+    setMatrixFromTriplets(reader.model, reader.triplets);
+    return reader.model;
+}
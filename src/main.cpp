@@ -13,5 +13,5 @@ using namespace std;
 
 int main(int argc, char** argv) {
     CLI interface(argc, argv);
-    return 0;
+    return interface.getExitCode();
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "mapped_file.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// PUBLIC METHODS
+
+MappedFile::MappedFile(const std::string& fileName) {
+    data = NULL;
+    size = 0;
+
+    fileDescriptor = open(fileName.c_str(), O_RDONLY);
+    if(fileDescriptor < 0) return;
+
+    struct stat fileStatus;
+    if(fstat(fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode) || fileStatus.st_size == 0) return;
+
+    void* mapping = mmap(NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if(mapping == MAP_FAILED) return;
+
+    data = mapping;
+    size = fileStatus.st_size;
+    madvise(data, size, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile() {
+    if(data != NULL) munmap(data, size);
+    if(fileDescriptor >= 0) close(fileDescriptor);
+}
@@ -0,0 +1,27 @@
+#include "memory_usage.h"
+
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+
+bool resetPeakMemory() {
+    // writing 5 to clear_refs resets the VmHWM(peak resident set size) of /proc/self/status, since Linux 4.0
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if(!clearRefs) return false;
+    clearRefs << "5";
+    clearRefs.close();
+    return !clearRefs.fail();
+}
+
+size_t getPeakMemory() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line)) {
+        if(line.compare(0, 6, "VmHWM:") == 0) return std::stoul(line.substr(6));
+    }
+
+    // the kernel's peak, which can't be reset
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_maxrss;
+}
@@ -0,0 +1,244 @@
+#include "model_generator.h"
+
+#include <cmath>
+#include <stdexcept>
+
+// PRIVATE METHODS
+
+ModelGenerator::ModelGenerator(uint64_t seed) : random(seed) {}
+
+uint ModelGenerator::uniform(uint low, uint high) {
+    return low + random() % (high - low + 1);
+}
+
+bool ModelGenerator::chance(double probability) {
+    return (random() >> 11) * 0x1.0p-53 < probability;
+}
+
+SparseModel ModelGenerator::emptyModel(const std::string& name, ProblemType type, uint nColumns, double upperBound) {
+    SparseModel model = emptySparseModel();
+    model.name = name;
+    model.type = type;
+    model.objective.assign(nColumns, 0);
+    model.lowerBounds.assign(nColumns, 0);
+    model.upperBounds.assign(nColumns, upperBound);
+    model.integer.assign(nColumns, true);
+    for(uint j = 0; j < nColumns; j++) model.columnNames.push_back("x" + std::to_string(j + 1));
+    return model;
+}
+
+void ModelGenerator::addRow(SparseModel& model, TripletBuffer& triplets, const std::vector<std::pair<uint, double>>& entries, ConstraintType rowType, double rhs) {
+    uint row = model.rowTypes.size();
+    for(const std::pair<uint, double>& entry : entries) {
+        triplets.rows.push_back(row);
+        triplets.columns.push_back(entry.first);
+        triplets.values.push_back(entry.second);
+    }
+
+    model.rowNames.push_back("R" + std::to_string(row + 1));
+    model.rowTypes.push_back(rowType);
+    model.rhs.push_back(rhs);
+    model.ranges.push_back(NAN);
+}
+
+SparseModel ModelGenerator::generateKnapsack(uint nItems, uint nConstraints) {
+    SparseModel model = emptyModel("knapsack", MAX, nItems, 1);
+    TripletBuffer triplets = emptyTripletBuffer();
+
+    std::vector<double> totalWeights(nItems, 0);
+    for(uint i = 0; i < nConstraints; i++) {
+        std::vector<std::pair<uint, double>> weights;
+        double capacity = 0;
+        for(uint j = 0; j < nItems; j++) {
+            double weight = uniform(1, 100);
+            weights.push_back(std::make_pair(j, weight));
+            totalWeights[j] += weight;
+            capacity += weight;
+        }
+        addRow(model, triplets, weights, LESS_THAN_OR_EQUAL, std::floor(capacity / 2));
+    }
+
+    // profits correlated with the weights make the instances harder than independent ones
+    for(uint j = 0; j < nItems; j++) model.objective[j] = std::round(totalWeights[j] / nConstraints) + uniform(1, 50);
+
+    setMatrixFromTriplets(model, triplets);
+    return model;
+}
+
+SparseModel ModelGenerator::generateSetCover(uint nSets, uint nElements, double density) {
+    SparseModel model = emptyModel("set_cover", MIN, nSets, 1);
+    TripletBuffer triplets = emptyTripletBuffer();
+
+    for(uint j = 0; j < nSets; j++) model.objective[j] = uniform(1, 100);
+
+    for(uint i = 0; i < nElements; i++) {
+        std::vector<std::pair<uint, double>> sets;
+        for(uint j = 0; j < nSets; j++) {
+            if(chance(density)) sets.push_back(std::make_pair(j, 1.0));
+        }
+
+        // every element must be in some set, or the model is infeasible
+        if(sets.empty()) sets.push_back(std::make_pair(uniform(0, nSets - 1), 1.0));
+        addRow(model, triplets, sets, GREATER_THAN_OR_EQUAL, 1);
+    }
+
+    setMatrixFromTriplets(model, triplets);
+    return model;
+}
+
+SparseModel ModelGenerator::generateAssignment(uint nAgents) {
+    // x(a, t) = 1 if agent a does task t, variable a * nAgents + t
+    SparseModel model = emptyModel("assignment", MIN, nAgents * nAgents, 1);
+    TripletBuffer triplets = emptyTripletBuffer();
+
+    for(uint j = 0; j < nAgents * nAgents; j++) model.objective[j] = uniform(1, 100);
+
+    for(uint a = 0; a < nAgents; a++) {
+        std::vector<std::pair<uint, double>> tasks;
+        for(uint t = 0; t < nAgents; t++) tasks.push_back(std::make_pair(a * nAgents + t, 1.0));
+        addRow(model, triplets, tasks, EQUAL, 1);
+    }
+    for(uint t = 0; t < nAgents; t++) {
+        std::vector<std::pair<uint, double>> agents;
+        for(uint a = 0; a < nAgents; a++) agents.push_back(std::make_pair(a * nAgents + t, 1.0));
+        addRow(model, triplets, agents, EQUAL, 1);
+    }
+
+    setMatrixFromTriplets(model, triplets);
+    return model;
+}
+
+SparseModel ModelGenerator::generateFacilityLocation(uint nFacilities, uint nCustomers) {
+    // y(f) = 1 if facility f is open, variable f. x(f, c) = 1 if facility f serves customer c, variable nFacilities + f * nCustomers + c
+    SparseModel model = emptyModel("facility_location", MIN, nFacilities * (nCustomers + 1), 1);
+    TripletBuffer triplets = emptyTripletBuffer();
+
+    for(uint f = 0; f < nFacilities; f++) {
+        model.objective[f] = uniform(100, 300);
+        for(uint c = 0; c < nCustomers; c++) model.objective[nFacilities + f * nCustomers + c] = uniform(1, 100);
+    }
+
+    for(uint c = 0; c < nCustomers; c++) {
+        std::vector<std::pair<uint, double>> facilities;
+        for(uint f = 0; f < nFacilities; f++) facilities.push_back(std::make_pair(nFacilities + f * nCustomers + c, 1.0));
+        addRow(model, triplets, facilities, EQUAL, 1);
+    }
+
+    // aggregated linking rows(a facility serves customers only if it's open), which keep the model small but its LP relaxation weak
+    for(uint f = 0; f < nFacilities; f++) {
+        std::vector<std::pair<uint, double>> customers;
+        for(uint c = 0; c < nCustomers; c++) customers.push_back(std::make_pair(nFacilities + f * nCustomers + c, 1.0));
+        customers.push_back(std::make_pair(f, -(double)nCustomers));
+        addRow(model, triplets, customers, LESS_THAN_OR_EQUAL, 0);
+    }
+
+    setMatrixFromTriplets(model, triplets);
+    return model;
+}
+
+SparseModel ModelGenerator::generateRandomIp(uint nColumns, uint nRows, double density) {
+    SparseModel model = emptyModel("random_ip", MAX, nColumns, INFINITY);
+    TripletBuffer triplets = emptyTripletBuffer();
+
+    for(uint j = 0; j < nColumns; j++) model.objective[j] = uniform(1, 20);
+
+    std::vector<std::vector<std::pair<uint, double>>> rows(nRows);
+    std::vector<bool> usedColumns(nColumns, false);
+    for(uint i = 0; i < nRows; i++) {
+        for(uint j = 0; j < nColumns; j++) {
+            if(!chance(density)) continue;
+            rows[i].push_back(std::make_pair(j, (double)uniform(1, 20)));
+            usedColumns[j] = true;
+        }
+        if(rows[i].empty()) {
+            uint j = uniform(0, nColumns - 1);
+            rows[i].push_back(std::make_pair(j, (double)uniform(1, 20)));
+            usedColumns[j] = true;
+        }
+    }
+
+    // a variable in no constraint would make the model unbounded
+    for(uint j = 0; j < nColumns; j++) {
+        if(!usedColumns[j]) rows[uniform(0, nRows - 1)].push_back(std::make_pair(j, (double)uniform(1, 20)));
+    }
+
+    for(const std::vector<std::pair<uint, double>>& row : rows) {
+        double sum = 0;
+        for(const std::pair<uint, double>& entry : row) sum += entry.second;
+        addRow(model, triplets, row, LESS_THAN_OR_EQUAL, std::max(1.0, std::floor(sum / 2)));
+    }
+
+    setMatrixFromTriplets(model, triplets);
+    return model;
+}
+
+// PUBLIC METHODS
+
+SparseModel ModelGenerator::generate(const GeneratorOptions& options) {
+    if(options.size == 0) throw std::invalid_argument("The size of a generated model must be at least 1");
+    if(options.density < 0 || options.density > 1) throw std::invalid_argument("The density of a generated model must be between 0 and 1");
+
+    ModelGenerator generator(options.seed);
+    SparseModel model;
+    switch(options.family) {
+    case ModelFamily::KNAPSACK:
+        model = generator.generateKnapsack(options.size, options.rows ? options.rows : 5);
+        break;
+    case ModelFamily::SET_COVER:
+        model = generator.generateSetCover(options.size, options.rows ? options.rows : std::max(1u, options.size / 2), options.density ? options.density : 0.2);
+        break;
+    case ModelFamily::ASSIGNMENT:
+        model = generator.generateAssignment(options.size);
+        break;
+    case ModelFamily::FACILITY_LOCATION:
+        model = generator.generateFacilityLocation(options.size, options.rows ? options.rows : 2 * options.size);
+        break;
+    case ModelFamily::RANDOM_IP:
+        model = generator.generateRandomIp(options.size, options.rows ? options.rows : std::max(1u, options.size / 2), options.density ? options.density : 0.3);
+        break;
+    }
+
+    model.name += "_" + std::to_string(options.size) + "_" + std::to_string(options.seed);
+    return model;
+}
+
+GeneratorOptions ModelGenerator::defaultOptions(ModelFamily family) {
+    GeneratorOptions options;
+    options.family = family;
+    options.size = 10;
+    options.rows = 0;
+    options.density = 0;
+    options.seed = 1;
+    return options;
+}
+
+std::string convertModelFamilyToString(ModelFamily family) {
+    std::string returnValue;
+    switch (family)
+    {
+    case ModelFamily::KNAPSACK:
+        returnValue = "knapsack";
+        break;
+    case ModelFamily::SET_COVER:
+        returnValue = "set_cover";
+        break;
+    case ModelFamily::ASSIGNMENT:
+        returnValue = "assignment";
+        break;
+    case ModelFamily::FACILITY_LOCATION:
+        returnValue = "facility_location";
+        break;
+    case ModelFamily::RANDOM_IP:
+        returnValue = "random_ip";
+        break;
+    }
+
+    return returnValue;
+}
+
+ModelFamily convertStringToModelFamily(const std::string& name) {
+    for(ModelFamily family : {ModelFamily::KNAPSACK, ModelFamily::SET_COVER, ModelFamily::ASSIGNMENT, ModelFamily::FACILITY_LOCATION, ModelFamily::RANDOM_IP}) {
+        if(convertModelFamilyToString(family) == name) return family;
+    }
+    throw std::invalid_argument("Invalid model family: " + name);
+}
@@ -0,0 +1,91 @@
+#include "model_hash.h"
+
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// a 64 bit hash function: its initial state and the multipliers of its finalizer
+typedef struct {
+    uint64_t seed;
+    uint64_t multiplier1;
+    uint64_t multiplier2;
+}HashFunction;
+
+// splitmix64 and murmur3's fmix64, which share no constant
+const HashFunction KEY_HASH = {0x9e3779b97f4a7c15ull, 0xbf58476d1ce4e5b9ull, 0x94d049bb133111ebull};
+const HashFunction CHECK_HASH = {0xc2b2ae3d27d4eb4full, 0xff51afd7ed558ccdull, 0xc4ceb9fe1a85ec53ull};
+
+uint64_t mix(const HashFunction& function, uint64_t value) {
+    value ^= value >> 30;
+    value *= function.multiplier1;
+    value ^= value >> 27;
+    value *= function.multiplier2;
+    value ^= value >> 31;
+    return value;
+}
+
+uint64_t combine(const HashFunction& function, uint64_t hash, uint64_t value) {
+    return mix(function, hash ^ (value + function.seed + (hash << 6) + (hash >> 2)));
+}
+
+// the exact bit pattern of `value`, -0 and 0 being the same coefficient
+uint64_t getBits(double value) {
+    if(value == 0) value = 0;
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// the values of `problem` which don't depend on the order of its rows: type, variables, objective function(and its constant term) and bounds
+std::vector<uint64_t> getColumnValues(LpProblem& problem) {
+    uint nVariables = problem.getObjectiveFunction().getNColumns();
+
+    std::vector<uint64_t> values = {(uint64_t)problem.getType(), (uint64_t)nVariables, getBits(problem.getObjectiveOffset())};
+    for(uint j = 0; j < nVariables; j++) {
+        values.push_back(getBits(problem.getObjectiveFunction().getElement(0, j)));
+        values.push_back(getBits(problem.getLowerBounds()[j]));
+        values.push_back(getBits(problem.getUpperBounds()[j]));
+    }
+    return values;
+}
+
+uint64_t hashValues(const HashFunction& function, const std::vector<uint64_t>& values) {
+    uint64_t hash = mix(function, function.seed);
+    for(uint64_t value : values) hash = combine(function, hash, value);
+    return hash;
+}
+
+}
+
+ModelFingerprint canonicalModelFingerprint(LpProblem& problem) {
+    std::vector<Constraint>& constraints = problem.getConstraints();
+
+    // each row is hashed by both functions, and the rows are combined sorted by their pair of hashes, which makes the fingerprint
+    // independent of the order they were written in
+    std::vector<std::pair<uint64_t, uint64_t>> rowHashes;
+    rowHashes.reserve(constraints.size());
+    std::vector<uint64_t> rowValues;
+    for(Constraint& constraint : constraints) {
+        rowValues.clear();
+        rowValues.push_back((uint64_t)constraint.getType());
+        for(double coefficient : constraint.getLhs()) rowValues.push_back(getBits(coefficient));
+        rowValues.push_back(getBits(constraint.getRhs()));
+        rowHashes.emplace_back(hashValues(KEY_HASH, rowValues), hashValues(CHECK_HASH, rowValues));
+    }
+    std::sort(rowHashes.begin(), rowHashes.end());
+
+    std::vector<uint64_t> columnValues = getColumnValues(problem);
+    ModelFingerprint fingerprint = {hashValues(KEY_HASH, columnValues), hashValues(CHECK_HASH, columnValues)};
+    fingerprint.key = combine(KEY_HASH, fingerprint.key, (uint64_t)rowHashes.size());
+    fingerprint.check = combine(CHECK_HASH, fingerprint.check, (uint64_t)rowHashes.size());
+    for(const std::pair<uint64_t, uint64_t>& rowHash : rowHashes) {
+        fingerprint.key = combine(KEY_HASH, fingerprint.key, rowHash.first);
+        fingerprint.check = combine(CHECK_HASH, fingerprint.check, rowHash.second);
+    }
+
+    return fingerprint;
+}
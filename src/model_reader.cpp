@@ -1,180 +1,364 @@
 #include "../include/model_reader.h"
+#include "../include/mapped_file.h"
+#include "../include/mps_reader.h"
+#include "../include/lp_format_reader.h"
+#include "../include/binary_model.h"
+#include "../include/decompress.h"
+#include "../include/trace.h"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
-#include <regex>
 #include <string>
 #include <algorithm>
-#include <iomanip>
+#include <filesystem>
 #include <cmath>
+#include <thread>
+#include <exception>
+#include <memory>
 
 // private methods
 
-std::pair<std::string, std::vector<double>> ModelFileReader::readObjectiveFunction(std::string fileName) {
-    std::ifstream file(fileName);
-    if (!file) {
-        std::cerr << "Error: Cannot open file.\n";
-        //return 1;
+std::string ModelFileReader::readFile(std::string fileName) {
+    std::ifstream file;
+    if(fileName != STDIN_FILE_NAME) {
+        file.open(fileName, std::ios::binary);
+        if(!file) {
+            throw std::invalid_argument("Cannot open model file " + fileName);
+        }
     }
+    std::istream& input = (fileName == STDIN_FILE_NAME) ? std::cin : file;
 
-    std::string line;
-    std::vector<double> objectiveCoefficients;
-    std::vector<std::vector<double>> constraintsCoefficients;
-    std::vector<double> rhsValues;
-    std::vector<std::string> inequalitySigns;
+    // the size isn't known in advance for pipes, so the file is read in blocks
+    std::string contents;
+    char buffer[1 << 16];
+    while(input.read(buffer, sizeof(buffer)) || input.gcount() > 0) contents.append(buffer, input.gcount());
+    return contents;
+}
 
-    // --- Read objective function ---
-    if (!std::getline(file, line)) {
-        std::cerr << "Error: Missing objective function.\n";
-        //return 1;
-    }
+void ModelFileReader::readTerms(ModelTokenizer& tokenizer, std::vector<std::pair<uint, double>>& terms) {
+    terms.clear();
 
-    std::smatch match;
-    std::regex headerRegex(R"((max|min):\s*(.*))");
-    if (!std::regex_match(line, match, headerRegex)) {
-        std::cerr << "Error: Invalid objective function format.\n";
-        //return 1;
-    }
+    while(true) {
+        TokenType type = tokenizer.peek().type;
+        if(type != TokenType::PLUS && type != TokenType::MINUS && type != TokenType::NUMBER && type != TokenType::IDENTIFIER) return;
 
-    //std::cout << match[1] << std::endl;
-    std::string problemType = match[1];
+        double coefficient = 1;
+        while(tokenizer.peek().type == TokenType::PLUS || tokenizer.peek().type == TokenType::MINUS) {
+            if(tokenizer.next().type == TokenType::MINUS) coefficient = -coefficient;
+        }
+        if(tokenizer.peek().type == TokenType::NUMBER) coefficient *= tokenizer.next().value;
 
-    std::string expr = match[2]; // part after 'max:' or 'min:'
-    std::regex termRegex(R"(([+-]?\s*\d*\.?\d*)x(\d+))");
+        Token variable = tokenizer.next();
+        if(variable.type != TokenType::IDENTIFIER || variable.text.size() < 2 || variable.text[0] != 'x') {
+            std::ostringstream errorMsg;
+            errorMsg << "Expected a variable(x1, x2, ...) on line " << variable.line;
+            throw std::invalid_argument(errorMsg.str());
+        }
 
-    int maxIndex = 0;
-    std::vector<std::pair<int, double>> objTerms;
+        uint index = 0;
+        for(size_t i = 1; i < variable.text.size(); i++) {
+            if(variable.text[i] < '0' || variable.text[i] > '9') {
+                std::ostringstream errorMsg;
+                errorMsg << "Invalid variable name " << variable.text << " on line " << variable.line;
+                throw std::invalid_argument(errorMsg.str());
+            }
+            index = index * 10 + (variable.text[i] - '0');
+        }
+        if(index == 0) {
+            std::ostringstream errorMsg;
+            errorMsg << "Variable indexes start at 1(x0 on line " << variable.line << ")";
+            throw std::invalid_argument(errorMsg.str());
+        }
 
-    auto termsBegin = std::sregex_iterator(expr.begin(), expr.end(), termRegex);
-    auto termsEnd = std::sregex_iterator();
+        terms.emplace_back(index - 1, coefficient);
+    }
+}
 
-    for (auto it = termsBegin; it != termsEnd; ++it) {
-        std::string coeffStr = (*it)[1].str();
-        std::string indexStr = (*it)[2].str();
+void ModelFileReader::readConstraints(std::string_view text, uint firstLine, uint nVariables, ConstraintChunk& chunk) {
+    ModelTokenizer tokenizer(text, firstLine);
+    std::vector<std::pair<uint, double>> terms;
 
-        coeffStr.erase(remove_if(coeffStr.begin(), coeffStr.end(), ::isspace), coeffStr.end());
-        if (coeffStr.empty() || coeffStr == "+") coeffStr = "1";
-        else if (coeffStr == "-") coeffStr = "-1";
+    while(tokenizer.peek().type != TokenType::END_OF_INPUT) {
+        if(tokenizer.peek().type == TokenType::NEWLINE) {
+            tokenizer.next();
+            continue;
+        }
 
-        int varIndex = std::stoi(indexStr) - 1;
-        double coeff = std::stod(coeffStr);
-        objTerms.emplace_back(varIndex, coeff);
-        maxIndex = std::max(maxIndex, varIndex);
-    }
+        uint line = tokenizer.peek().line;
+        readTerms(tokenizer, terms);
 
-    objectiveCoefficients.resize(maxIndex + 1, 0.0);
-    for (const auto& [index, value] : objTerms) {
-        objectiveCoefficients[index] = value;
-    }
+        TokenType relation = tokenizer.peek().type;
+        if(relation != TokenType::LESS_EQUAL && relation != TokenType::GREATER_EQUAL && relation != TokenType::EQUAL) {
+            chunk.warnings.push_back("Warning: Skipping invalid constraint on line " + std::to_string(line));
+            tokenizer.skipLine();
+            continue;
+        }
+        tokenizer.next();
 
-    std::pair<std::string, std::vector<double>> result(problemType, objectiveCoefficients);
-    return result;
+        double rhs = 1;
+        while(tokenizer.peek().type == TokenType::PLUS || tokenizer.peek().type == TokenType::MINUS) {
+            if(tokenizer.next().type == TokenType::MINUS) rhs = -rhs;
+        }
+        if(tokenizer.peek().type != TokenType::NUMBER) {
+            chunk.warnings.push_back("Warning: Skipping constraint without right hand side on line " + std::to_string(line));
+            tokenizer.skipLine();
+            continue;
+        }
+        rhs *= tokenizer.next().value;
+
+        uint row = chunk.rowTypes.size();
+        for(const std::pair<uint, double>& term : terms) {
+            if(term.first >= nVariables) {
+                std::ostringstream errorMsg;
+                errorMsg << "Variable x" << term.first + 1 << " on line " << line << " doesn't appear in the objective function";
+                throw std::invalid_argument(errorMsg.str());
+            }
+            chunk.triplets.rows.push_back(row);
+            chunk.triplets.columns.push_back(term.first);
+            chunk.triplets.values.push_back(term.second);
+        }
+
+        chunk.rowTypes.push_back((relation == TokenType::LESS_EQUAL) ? LESS_THAN_OR_EQUAL : (relation == TokenType::GREATER_EQUAL) ? GREATER_THAN_OR_EQUAL : EQUAL);
+        chunk.rhs.push_back(rhs);
+        tokenizer.skipLine();
+    }
 }
 
-std::vector<std::tuple<std::vector<double>, std::string, double>> ModelFileReader::readConstraints(std::string fileName, unsigned varsNumber) {
-    std::ifstream file(fileName);
-    if (!file) {
-        std::cerr << "Error: Cannot open file.\n";
-        //return 1;
+SparseModel ModelFileReader::parseModel(std::string_view text, uint threads) {
+    ModelTokenizer tokenizer(text);
+    std::vector<std::pair<uint, double>> terms;
+    SparseModel model = emptySparseModel();
+
+    // --- Read objective function ---
+    Token header = tokenizer.next();
+    if(header.type != TokenType::IDENTIFIER || (header.text != "max" && header.text != "min") || tokenizer.next().type != TokenType::COLON) {
+        throw std::invalid_argument("Invalid objective function format: the model must start with max: or min:");
     }
+    model.type = (header.text == "max") ? MAX : MIN;
 
-    std::string line;
-    std::vector<double> objectiveCoefficients;
-    std::vector<std::vector<double>> constraintsCoefficients;
-    std::vector<double> rhsValues;
-    std::vector<std::string> inequalitySigns;
+    readTerms(tokenizer, terms);
+    uint nVariables = 0;
+    for(const std::pair<uint, double>& term : terms) nVariables = std::max(nVariables, term.first + 1);
 
-    std::vector<std::tuple<std::vector<double>, std::string, double>> allConstraints;
+    model.objective.assign(nVariables, 0.0);
+    for(const std::pair<uint, double>& term : terms) model.objective[term.first] += term.second;
 
-    // --- Read objective function ---
-    if (!std::getline(file, line)) {
-        std::cerr << "Error: Missing objective function.\n";
-        //return 1;
+    // --- Skip everything up to the blank line ---
+    tokenizer.skipLine();
+    while(tokenizer.peek().type != TokenType::NEWLINE && tokenizer.peek().type != TokenType::END_OF_INPUT) tokenizer.skipLine();
+
+    // --- Read constraints ---
+    // constraints are independent lines, so big constraint sections are split into pieces which are read concurrently
+    std::string_view section = text.substr(tokenizer.getOffset());
+    uint nPieces = std::max<size_t>(1, std::min<size_t>(threads, section.size() / PARALLEL_PARSE_MIN_CHUNK));
+    std::vector<std::string_view> pieces = splitLines(section, nPieces);
+    std::vector<ConstraintChunk> chunks(pieces.size());
+    std::vector<uint> firstLines(pieces.size(), tokenizer.peek().line);
+
+    if(pieces.size() == 1) readConstraints(pieces[0], firstLines[0], nVariables, chunks[0]);
+    else {
+        std::vector<std::exception_ptr> errors(pieces.size());
+        std::vector<std::thread> workers;
+
+        // the line breaks of each piece are counted first, so that every piece knows its first line number
+        std::vector<uint> lineCounts(pieces.size());
+        for(uint k = 0; k < pieces.size(); k++) {
+            workers.emplace_back([&pieces, &lineCounts, k]() { lineCounts[k] = std::count(pieces[k].begin(), pieces[k].end(), '\n'); });
+        }
+        for(std::thread& worker : workers) worker.join();
+        for(uint k = 1; k < pieces.size(); k++) firstLines[k] = firstLines[k - 1] + lineCounts[k - 1];
+
+        workers.clear();
+        for(uint k = 0; k < pieces.size(); k++) {
+            workers.emplace_back([&, k]() {
+                TRACE_THREAD_NAME("parse worker " + std::to_string(k));
+                TRACE_SCOPE("parse piece", "parse", "piece", k, "bytes", pieces[k].size());
+                try {
+                    readConstraints(pieces[k], firstLines[k], nVariables, chunks[k]);
+                }
+                catch(...) {
+                    errors[k] = std::current_exception();
+                }
+            });
+        }
+        for(std::thread& worker : workers) worker.join();
+
+        // the first error in the file is reported, as a single threaded parse would
+        for(std::exception_ptr& error : errors) {
+            if(error) std::rethrow_exception(error);
+        }
     }
-    std::regex termRegex(R"(([+-]?\s*\d*\.?\d*)x(\d+))");
 
-    // --- Skip blank line ---
-    while (std::getline(file, line)) {
-        if (line.empty()) break;
+    // --- Merge the pieces ---
+    std::vector<TripletBuffer> triplets;
+    for(ConstraintChunk& chunk : chunks) {
+        for(const std::string& warning : chunk.warnings) std::cerr << warning << "\n";
+
+        chunk.triplets.rowOffset = model.rowTypes.size();
+        model.rowTypes.insert(model.rowTypes.end(), chunk.rowTypes.begin(), chunk.rowTypes.end());
+        model.rhs.insert(model.rhs.end(), chunk.rhs.begin(), chunk.rhs.end());
+        triplets.push_back(std::move(chunk.triplets));
     }
 
-    // --- Read constraints ---
-    std::regex constraintRegex(R"(.*?(<=|>=|=)\s*(-?\d+\.?\d*))");
+    uint nRows = model.rowTypes.size();
+    model.ranges.assign(nRows, NAN);
+    for(uint i = 0; i < nRows; i++) model.rowNames.push_back("R" + std::to_string(i + 1));
+    for(uint j = 0; j < nVariables; j++) model.columnNames.push_back("x" + std::to_string(j + 1));
+    model.lowerBounds.assign(nVariables, 0.0);
+    model.upperBounds.assign(nVariables, INFINITY);
+    model.integer.assign(nVariables, true);
+    setMatrixFromTriplets(model, triplets);
 
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
+    return model;
+}
 
-        std::smatch rhsMatch;
-        if (!std::regex_search(line, rhsMatch, constraintRegex)) {
-            std::cerr << "Warning: Skipping invalid constraint line: " << line << "\n";
-            continue;
-        }
+// public methods
 
-        std::string inequality = rhsMatch[1];
-        double rhs = std::stod(rhsMatch[2]);
-        inequalitySigns.push_back(inequality);
-        rhsValues.push_back(rhs);
+std::vector<std::string_view> ModelFileReader::splitLines(std::string_view text, uint nPieces) {
+    std::vector<std::string_view> pieces;
+    size_t pieceSize = text.size() / nPieces, start = 0;
 
-        std::string lhsPart = line.substr(0, rhsMatch.position(1)); // LHS up to inequality
-        std::vector<std::pair<int, double>> constraintTerms;
-        int maxVarInConstraint = 0;
-        int globalMaxVarIndex = 0;
+    for(uint k = 1; k < nPieces; k++) {
+        size_t end = text.find('\n', std::max(start, k * pieceSize));
+        if(end == std::string_view::npos) break;
 
-        auto lhsTermsBegin = std::sregex_iterator(lhsPart.begin(), lhsPart.end(), termRegex);
-        auto lhsTermsEnd = std::sregex_iterator();
+        pieces.push_back(text.substr(start, end + 1 - start));
+        start = end + 1;
+    }
+    pieces.push_back(text.substr(start));
 
-        for (auto it = lhsTermsBegin; it != lhsTermsEnd; ++it) {
-            std::string coeffStr = (*it)[1].str();
-            std::string indexStr = (*it)[2].str();
+    return pieces;
+}
 
-            coeffStr.erase(remove_if(coeffStr.begin(), coeffStr.end(), ::isspace), coeffStr.end());
-            if (coeffStr.empty() || coeffStr == "+") coeffStr = "1";
-            else if (coeffStr == "-") coeffStr = "-1";
+ModelFileReader::ModelFileReader() {
+    
+}
 
-            int varIndex = std::stoi(indexStr) - 1;
-            double coeff = std::stod(coeffStr);
-            constraintTerms.emplace_back(varIndex, coeff);
-            maxVarInConstraint = std::max(maxVarInConstraint, varIndex);
-            globalMaxVarIndex = std::max(globalMaxVarIndex, varIndex);
+SparseModel ModelFileReader::parseMps(std::string_view text, uint threads) {
+    SparseModel model;
+    try {
+        model = MpsReader::parse(text, MpsFormat::FREE, threads);
+    }
+    catch(const std::invalid_argument& freeError) {
+        // names with spaces are only allowed by fixed MPS, which free MPS parsing usually rejects
+        try {
+            model = MpsReader::parse(text, MpsFormat::FIXED, threads);
         }
+        catch(const std::invalid_argument& fixedError) {
+            throw freeError;
+        }
+    }
+
+    return model;
+}
 
-        std::vector<double> coeffs(varsNumber, 0.0);
-        for (const auto& [index, value] : constraintTerms) {
-            coeffs[index] = value;
+bool ModelFileReader::isLegacyFormat(std::string_view text) {
+    ModelTokenizer tokenizer(text);
+    while(tokenizer.peek().type == TokenType::NEWLINE) tokenizer.next();
+
+    Token header = tokenizer.next();
+    return header.type == TokenType::IDENTIFIER && (header.text == "max" || header.text == "min") && tokenizer.peek().type == TokenType::COLON;
+}
+
+LpProblem ModelFileReader::buildProblem(const SparseModel& model) {
+    for(uint j = 0; j < model.integer.size(); j++) {
+        if(!model.integer[j]) {
+            std::cerr << "Warning: the model has continuous variables, which are solved as integer variables\n";
+            break;
         }
+    }
 
-        constraintsCoefficients.push_back(coeffs);
+    return sparseModelToLpProblem(model);
+}
 
-        //constraintsCoefficients[0].resize();
+SparseModel ModelFileReader::parseText(std::string_view text, bool mps, uint threads) {
+    if(mps) return parseMps(text, threads);
+    if(isLegacyFormat(text)) return parseModel(text, threads);
+    return LpFormatReader::parse(text);
+}
 
-        std::tuple<std::vector<double>, std::string, double> constraint(coeffs, inequality, rhs);
-        allConstraints.push_back(constraint);
+bool ModelFileReader::isMpsModel(const std::string& fileName, std::string_view text) {
+    if(fileName != STDIN_FILE_NAME) {
+        std::string_view name = fileName;
+        for(std::string_view extension : {".gz", ".zst"}) {
+            if(name.size() >= extension.size() && name.substr(name.size() - extension.size()) == extension) name.remove_suffix(extension.size());
+        }
+        return name.size() >= 4 && name.substr(name.size() - 4) == ".mps";
     }
 
-    return allConstraints;
+    // the first line that isn't empty or a comment(*) starts with a section keyword in MPS models
+    size_t position = 0;
+    while(position < text.size()) {
+        size_t end = text.find('\n', position);
+        if(end == std::string_view::npos) end = text.size();
+        std::string_view line = text.substr(position, end - position);
+        position = end + 1;
+
+        size_t start = line.find_first_not_of(" \t\r");
+        if(start == std::string_view::npos || line[0] == '*') continue;
+
+        std::string_view keyword = line.substr(start, line.find_first_of(" \t\r", start) - start);
+        return keyword == "NAME" || keyword == "ROWS" || keyword == "OBJSENSE";
+    }
+    return false;
 }
 
-// public methods
+SparseModel ModelFileReader::parseFile(std::string fileName, uint threads) {
+    // the model is read directly out of the mapped pages, without copying it
+    std::unique_ptr<MappedFile> mappedFile;
+    if(fileName != STDIN_FILE_NAME) mappedFile = std::make_unique<MappedFile>(fileName);
+
+    std::string contents;
+    std::string_view text;
+    if(mappedFile != NULL && mappedFile->isMapped()) text = mappedFile->getContents();
+    else {
+        contents = readFile(fileName);
+        text = contents;
+    }
 
-ModelFileReader::ModelFileReader() {
-    
+    // compressed models are decompressed into memory, so no temporary file is needed
+    Compression compression = detectCompression(text);
+    if(compression != Compression::NONE) {
+        std::string decompressed = decompress(text, compression);
+        mappedFile.reset();
+        contents = std::move(decompressed);
+        text = contents;
+    }
+
+    return parseText(text, isMpsModel(fileName, text), threads);
 }
 
-LpProblem ModelFileReader::readModel(std::string fileName) {
-    std::pair<std::string, std::vector<double>> objectiveFunctionAux = readObjectiveFunction(fileName);
-    std::vector<std::tuple<std::vector<double>, std::string, double>> constraintsAux = readConstraints(fileName, objectiveFunctionAux.second.size());
+LpProblem ModelFileReader::readModel(std::string fileName, bool useCache, uint threads) {
+    return buildProblem(readSparseModel(fileName, useCache, threads));
+}
 
-    ProblemType type;
-    if(objectiveFunctionAux.first == "max") type = MAX;
-    else if(objectiveFunctionAux.first == "min") type = MIN;
+SparseModel ModelFileReader::readSparseModel(std::string fileName, bool useCache, uint threads) {
+    // only regular files can be cached, since the cache is invalidated by the source's size and modification time
+    if(!useCache || !std::filesystem::is_regular_file(fileName)) return parseFile(fileName, threads);
+
+    ModelSourceStamp source = BinaryModel::getSourceStamp(fileName);
+    std::string cacheName = fileName + BINARY_MODEL_EXTENSION;
+    {
+        MappedFile cacheFile(cacheName);
+        if(cacheFile.isMapped() && BinaryModel::isUpToDate(cacheFile.getContents(), source)) {
+            try {
+                return BinaryModel::read(cacheFile.getContents());
+            }
+            catch(const std::invalid_argument& e) {
+                std::cerr << "Warning: ignoring model cache " << cacheName << ": " << e.what() << "\n";
+            }
+        }
+    }
 
-    std::vector<double> objectiveFunction = objectiveFunctionAux.second;
-    std::vector<Constraint> constraints;
-    for(std::tuple<std::vector<double>, std::string, double> consts : constraintsAux) {
-        constraints.push_back(Constraint(std::get<0>(consts), std::get<1>(consts),std::get<2>(consts)));
+    SparseModel model = parseFile(fileName, threads);
+    try {
+        BinaryModel::write(model, cacheName, source);
+    }
+    catch(const std::invalid_argument& e) {
+        std::cerr << "Warning: " << e.what() << "\n";
     }
 
-    return LpProblem(type, objectiveFunction, constraints);
-}
\ No newline at end of file
+    return model;
+}
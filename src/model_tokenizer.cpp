@@ -0,0 +1,117 @@
+#include "model_tokenizer.h"
+
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+// besides letters and digits, names may contain these characters(as in the CPLEX LP format)
+bool isNameCharacter(char c) {
+    return std::isalnum((unsigned char)c) || (c != '\0' && std::strchr("!\"#$%&()/,.;?@_`'{}|~", c) != NULL);
+}
+
+}
+
+// PRIVATE METHODS
+
+Token ModelTokenizer::scan() {
+    while(position < input.size()) {
+        if(input[position] == ' ' || input[position] == '\t' || input[position] == '\r') position++;
+        else if(input[position] == '\\') {
+            // comments run until the end of the line
+            while(position < input.size() && input[position] != '\n') position++;
+        }
+        else break;
+    }
+
+    Token token;
+    token.value = 0;
+    token.line = line;
+
+    if(position >= input.size()) {
+        token.type = TokenType::END_OF_INPUT;
+        token.text = std::string_view();
+        return token;
+    }
+
+    size_t start = position;
+    char c = input[position];
+
+    if(std::isdigit((unsigned char)c) || c == '.') {
+        const char* first = input.data() + position;
+        std::from_chars_result result = std::from_chars(first, input.data() + input.size(), token.value);
+        if(result.ec != std::errc()) {
+            std::ostringstream errorMsg;
+            errorMsg << "Invalid number on line " << line;
+            throw std::invalid_argument(errorMsg.str());
+        }
+        position += result.ptr - first;
+        token.type = TokenType::NUMBER;
+    }
+    else if(isNameCharacter(c)) {
+        // names can't start with a digit or a period, which start numbers instead
+        while(position < input.size() && isNameCharacter(input[position])) position++;
+        token.type = TokenType::IDENTIFIER;
+    }
+    else if(c == '<' || c == '>') {
+        position++;
+        if(position < input.size() && input[position] == '=') position++;
+        token.type = (c == '<') ? TokenType::LESS_EQUAL : TokenType::GREATER_EQUAL;
+    }
+    else if(c == '=') {
+        position++;
+        // "=<" and "=>" are accepted as well
+        if(position < input.size() && (input[position] == '<' || input[position] == '>')) {
+            token.type = (input[position] == '<') ? TokenType::LESS_EQUAL : TokenType::GREATER_EQUAL;
+            position++;
+        }
+        else token.type = TokenType::EQUAL;
+    }
+    else if(c == '+' || c == '-' || c == ':' || c == '\n') {
+        position++;
+        if(c == '+') token.type = TokenType::PLUS;
+        else if(c == '-') token.type = TokenType::MINUS;
+        else if(c == ':') token.type = TokenType::COLON;
+        else {
+            token.type = TokenType::NEWLINE;
+            line++;
+        }
+    }
+    else {
+        std::ostringstream errorMsg;
+        errorMsg << "Unexpected character '" << c << "' on line " << line;
+        throw std::invalid_argument(errorMsg.str());
+    }
+
+    token.text = input.substr(start, position - start);
+    return token;
+}
+
+// PUBLIC METHODS
+
+ModelTokenizer::ModelTokenizer(std::string_view text, uint firstLine) {
+    input = text;
+    position = 0;
+    line = firstLine;
+    current = scan();
+}
+
+Token ModelTokenizer::next() {
+    Token token = current;
+    if(token.type != TokenType::END_OF_INPUT) current = scan();
+    return token;
+}
+
+void ModelTokenizer::skipLine() {
+    if(current.type == TokenType::END_OF_INPUT) return;
+    if(current.type != TokenType::NEWLINE) {
+        // the rest of the line is skipped without being tokenized, so it may contain anything
+        size_t newline = input.find('\n', position);
+        position = (newline == std::string_view::npos) ? input.size() : newline;
+        current = scan();
+    }
+    next();
+}
@@ -0,0 +1,160 @@
+#include "../include/model_writer.h"
+
+#include <cmath>
+
+// private methods
+
+void ModelFileWriter::writeLpTerm(BufferedWriter& writer, double coefficient, uint column, bool first) {
+    if(coefficient < 0) writer << (first ? "-" : "- ");
+    else if(!first) writer << "+ ";
+
+    double magnitude = std::fabs(coefficient);
+    if(magnitude != 1) writer << magnitude << ' ';
+    writer << 'x' << column + 1;
+}
+
+void ModelFileWriter::writeLp(LpProblem& problem, BufferedWriter& writer) {
+    uint nVariables = problem.getObjectiveFunction().getNColumns();
+    std::vector<Constraint>& constraints = problem.getConstraints();
+
+    // --- Objective function ---
+    // LP format readers number the variables in the order they first appear, so every variable is written here, even with a 0 coefficient
+    writer << ((problem.getType() == MAX) ? "Maximize\n" : "Minimize\n") << " obj:";
+    for(uint j = 0; j < nVariables; j++) {
+        if(j > 0 && j % LP_FORMAT_TERMS_PER_LINE == 0) writer << "\n   ";
+        writer << ' ';
+        writeLpTerm(writer, problem.getObjectiveFunction().getElement(0, j), j, j == 0);
+    }
+    double offset = problem.getObjectiveOffset();
+    if(offset != 0) writer << ((offset < 0) ? " - " : " + ") << std::fabs(offset);
+    writer << '\n';
+
+    // --- Constraints ---
+    writer << "Subject To\n";
+    for(uint i = 0; i < constraints.size(); i++) {
+        std::vector<double>& lhs = constraints[i].getLhs();
+        writer << " R" << i + 1 << ":";
+
+        uint terms = 0;
+        for(uint j = 0; j < nVariables; j++) {
+            if(lhs[j] == 0) continue;
+
+            // long constraints are split into several lines, which the LP format allows
+            if(terms > 0 && terms % LP_FORMAT_TERMS_PER_LINE == 0) writer << "\n   ";
+            writer << ' ';
+            writeLpTerm(writer, lhs[j], j, terms == 0);
+            terms++;
+        }
+        if(terms == 0) writer << " 0 x1";
+
+        ConstraintType type = constraints[i].getType();
+        writer << ((type == LESS_THAN_OR_EQUAL) ? " <= " : (type == GREATER_THAN_OR_EQUAL) ? " >= " : " = ") << constraints[i].getRhs() << '\n';
+    }
+
+    // --- Bounds ---
+    std::vector<double>& lowerBounds = problem.getLowerBounds();
+    std::vector<double>& upperBounds = problem.getUpperBounds();
+    writer << "Bounds\n";
+    for(uint j = 0; j < nVariables; j++) {
+        double lower = lowerBounds[j], upper = upperBounds[j];
+        if(lower == 0 && std::isinf(upper)) continue;
+
+        if(lower == upper) writer << " x" << j + 1 << " = " << lower << '\n';
+        else if(std::isinf(lower) && std::isinf(upper)) writer << " x" << j + 1 << " free\n";
+        else if(std::isinf(upper)) writer << " x" << j + 1 << " >= " << lower << '\n';
+        else writer << ' ' << lower << " <= x" << j + 1 << " <= " << upper << '\n';
+    }
+
+    // --- Integer variables ---
+    writer << "General\n";
+    for(uint j = 0; j < nVariables; j++) {
+        writer << " x" << j + 1;
+        if((j + 1) % LP_FORMAT_TERMS_PER_LINE == 0 || j + 1 == nVariables) writer << '\n';
+    }
+
+    writer << "End\n";
+}
+
+void ModelFileWriter::writeMps(LpProblem& problem, BufferedWriter& writer) {
+    uint nVariables = problem.getObjectiveFunction().getNColumns();
+    std::vector<Constraint>& constraints = problem.getConstraints();
+
+    writer << "NAME model\n";
+    writer << "OBJSENSE\n    " << ((problem.getType() == MAX) ? "MAX" : "MIN") << '\n';
+
+    // --- Rows ---
+    writer << "ROWS\n N  obj\n";
+    for(uint i = 0; i < constraints.size(); i++) {
+        ConstraintType type = constraints[i].getType();
+        writer << ((type == LESS_THAN_OR_EQUAL) ? " L  R" : (type == GREATER_THAN_OR_EQUAL) ? " G  R" : " E  R") << i + 1 << '\n';
+    }
+
+    // --- Columns(the constraints are stored by rows, so each column gathers its entries from every row) ---
+    writer << "COLUMNS\n    MARKER 'MARKER' 'INTORG'\n";
+    for(uint j = 0; j < nVariables; j++) {
+        double objectiveCoefficient = problem.getObjectiveFunction().getElement(0, j);
+        bool written = false;
+
+        if(objectiveCoefficient != 0) {
+            writer << "    x" << j + 1 << " obj " << objectiveCoefficient << '\n';
+            written = true;
+        }
+        for(uint i = 0; i < constraints.size(); i++) {
+            double value = constraints[i].getLhs()[j];
+            if(value == 0) continue;
+
+            writer << "    x" << j + 1 << " R" << i + 1 << ' ' << value << '\n';
+            written = true;
+        }
+
+        // columns without entries still have to appear, or the variable would be lost
+        if(!written) writer << "    x" << j + 1 << " obj 0\n";
+    }
+    writer << "    MARKER 'MARKER' 'INTEND'\n";
+
+    // --- Right hand sides ---
+    writer << "RHS\n";
+    // the RHS of the objective row is the negated constant term of the objective function
+    if(problem.getObjectiveOffset() != 0) writer << "    RHS obj " << -problem.getObjectiveOffset() << '\n';
+    for(uint i = 0; i < constraints.size(); i++) {
+        if(constraints[i].getRhs() != 0) writer << "    RHS R" << i + 1 << ' ' << constraints[i].getRhs() << '\n';
+    }
+
+    // --- Bounds ---
+    std::vector<double>& lowerBounds = problem.getLowerBounds();
+    std::vector<double>& upperBounds = problem.getUpperBounds();
+    writer << "BOUNDS\n";
+    for(uint j = 0; j < nVariables; j++) {
+        double lower = lowerBounds[j], upper = upperBounds[j];
+
+        if(lower == upper) {
+            writer << " FX BND x" << j + 1 << ' ' << lower << '\n';
+            continue;
+        }
+        if(std::isinf(lower) && std::isinf(upper)) {
+            writer << " FR BND x" << j + 1 << '\n';
+            continue;
+        }
+
+        if(std::isinf(lower)) writer << " MI BND x" << j + 1 << '\n';
+        else if(lower != 0) writer << " LO BND x" << j + 1 << ' ' << lower << '\n';
+        if(!std::isinf(upper)) writer << " UP BND x" << j + 1 << ' ' << upper << '\n';
+    }
+
+    writer << "ENDATA\n";
+}
+
+// public methods
+
+ModelFileWriter::ModelFileWriter() {
+
+}
+
+void ModelFileWriter::writeModel(LpProblem& problem, std::string fileName) {
+    bool mps = fileName.size() >= 4 && fileName.compare(fileName.size() - 4, 4, ".mps") == 0;
+
+    BufferedWriter writer(fileName);
+    if(mps) writeMps(problem, writer);
+    else writeLp(problem, writer);
+    writer.close();
+}
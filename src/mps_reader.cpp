@@ -0,0 +1,412 @@
+#include "mps_reader.h"
+#include "model_reader.h"
+#include "trace.h"
+
+#include <charconv>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include <thread>
+#include <exception>
+#include <memory>
+
+#define MPS_INFINITY 1e30
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if(start == std::string_view::npos) return std::string_view();
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+/**
+ * @brief Returns the offset of the first section header line(a line which doesn't start with a blank or a comment) at or after `position`,
+ *        or the size of `text` if there's none
+ */
+size_t findSectionEnd(std::string_view text, size_t position) {
+    while(position < text.size()) {
+        char first = text[position];
+        if(first != ' ' && first != '\t' && first != '\r' && first != '\n' && first != '*') return position;
+
+        size_t end = text.find('\n', position);
+        if(end == std::string_view::npos) break;
+        position = end + 1;
+    }
+    return text.size();
+}
+
+}
+
+// PRIVATE METHODS
+
+MpsReader::MpsReader(MpsFormat mpsFormat, const MpsReader* rows) {
+    model = emptySparseModel();
+    format = mpsFormat;
+    section = MpsSection::NONE;
+    line = 0;
+    integerMarker = false;
+    rowSource = rows;
+    sawMarker = false;
+    firstMarkedColumn = 0;
+    if(rows != nullptr) objectiveRow = rows->objectiveRow;
+}
+
+void MpsReader::fail(const std::string& message) {
+    std::ostringstream errorMsg;
+    errorMsg << "MPS line " << line << ": " << message;
+    throw std::invalid_argument(errorMsg.str());
+}
+
+std::vector<std::string_view> MpsReader::splitFields(std::string_view text) {
+    std::vector<std::string_view> fields;
+
+    if(format == MpsFormat::FIXED) {
+        static const size_t fieldStart[] = {1, 4, 14, 24, 39, 49};
+        static const size_t fieldEnd[] = {3, 12, 22, 36, 47, 61};
+        for(uint k = 0; k < 6 && fieldStart[k] < text.size(); k++) {
+            std::string_view field = trim(text.substr(fieldStart[k], fieldEnd[k] - fieldStart[k]));
+            if(!field.empty()) fields.push_back(field);
+        }
+        return fields;
+    }
+
+    size_t position = 0;
+    while(position < text.size()) {
+        size_t start = text.find_first_not_of(" \t\r", position);
+        if(start == std::string_view::npos) break;
+        size_t end = text.find_first_of(" \t\r", start);
+        if(end == std::string_view::npos) end = text.size();
+        fields.push_back(text.substr(start, end - start));
+        position = end;
+    }
+    return fields;
+}
+
+double MpsReader::parseNumber(std::string_view field) {
+    if(!field.empty() && field[0] == '+') field.remove_prefix(1);
+
+    double value;
+    std::from_chars_result result = std::from_chars(field.data(), field.data() + field.size(), value);
+    if(result.ec != std::errc() || result.ptr != field.data() + field.size()) fail("invalid number " + std::string(field));
+    return value;
+}
+
+int MpsReader::findRow(std::string_view name) {
+    const std::unordered_map<std::string_view, int>& rows = (rowSource == nullptr) ? rowIndexes : rowSource->rowIndexes;
+    std::unordered_map<std::string_view, int>::const_iterator row = rows.find(name);
+    if(row == rows.end()) fail("unknown row " + std::string(name));
+    return row->second;
+}
+
+uint MpsReader::findColumn(std::string_view name) {
+    std::unordered_map<std::string_view, uint>::iterator column = columnIndexes.find(name);
+    if(column == columnIndexes.end()) fail("unknown column " + std::string(name));
+    return column->second;
+}
+
+void MpsReader::readHeader(std::string_view text) {
+    size_t end = text.find_first_of(" \t\r");
+    std::string_view keyword = text.substr(0, end);
+    std::string_view rest = (end == std::string_view::npos) ? std::string_view() : trim(text.substr(end));
+
+    if(keyword == "NAME") {
+        section = MpsSection::NAME;
+        model.name = std::string(rest);
+    }
+    else if(keyword == "OBJSENSE") {
+        section = MpsSection::OBJSENSE;
+        if(rest == "MAX" || rest == "MAXIMIZE") model.type = MAX;
+        else if(rest == "MIN" || rest == "MINIMIZE") model.type = MIN;
+    }
+    else if(keyword == "ROWS") section = MpsSection::ROWS;
+    else if(keyword == "COLUMNS") section = MpsSection::COLUMNS;
+    else if(keyword == "RHS") section = MpsSection::RHS;
+    else if(keyword == "RANGES") section = MpsSection::RANGES;
+    else if(keyword == "BOUNDS") section = MpsSection::BOUNDS;
+    else if(keyword == "ENDATA") section = MpsSection::ENDATA;
+    else fail("unknown section " + std::string(keyword));
+}
+
+void MpsReader::readRow(const std::vector<std::string_view>& fields) {
+    if(fields.size() != 2) fail("a row needs a type and a name");
+    if(rowIndexes.count(fields[1]) != 0) fail("duplicate row " + std::string(fields[1]));
+
+    if(fields[0] == "N") {
+        // the first free row is the objective function, the others are ignored
+        if(objectiveRow.empty()) objectiveRow = fields[1];
+        rowIndexes[fields[1]] = -1;
+        return;
+    }
+
+    if(fields[0] == "L") model.rowTypes.push_back(LESS_THAN_OR_EQUAL);
+    else if(fields[0] == "G") model.rowTypes.push_back(GREATER_THAN_OR_EQUAL);
+    else if(fields[0] == "E") model.rowTypes.push_back(EQUAL);
+    else fail("invalid row type " + std::string(fields[0]));
+
+    rowIndexes[fields[1]] = model.rowNames.size();
+    model.rowNames.push_back(std::string(fields[1]));
+    model.rhs.push_back(0);
+    model.ranges.push_back(NAN);
+}
+
+void MpsReader::readColumn(const std::vector<std::string_view>& fields) {
+    if(fields.size() >= 3 && fields[1] == "'MARKER'") {
+        if(!sawMarker) {
+            sawMarker = true;
+            firstMarkedColumn = model.columnNames.size();
+        }
+        if(fields[2] == "'INTORG'") integerMarker = true;
+        else if(fields[2] == "'INTEND'") integerMarker = false;
+        else fail("invalid marker " + std::string(fields[2]));
+        return;
+    }
+
+    if(fields.size() < 3 || fields.size() % 2 == 0) fail("a column entry needs a name and (row, value) pairs");
+
+    uint column;
+    if(!model.columnNames.empty() && model.columnNames.back() == fields[0]) column = model.columnNames.size() - 1;
+    else {
+        if(columnIndexes.count(fields[0]) != 0) fail("the entries of column " + std::string(fields[0]) + " aren't contiguous");
+
+        column = model.columnNames.size();
+        columnIndexes[fields[0]] = column;
+        model.columnNames.push_back(std::string(fields[0]));
+        model.columnStart.resize(column + 1, model.values.size());
+        model.objective.push_back(0);
+        model.lowerBounds.push_back(0);
+        model.upperBounds.push_back(INFINITY);
+        model.integer.push_back(integerMarker);
+    }
+
+    for(uint k = 1; k + 1 < fields.size(); k += 2) {
+        int row = findRow(fields[k]);
+        double value = parseNumber(fields[k + 1]);
+
+        if(row < 0) {
+            if(fields[k] == objectiveRow) model.objective[column] += value;
+        }
+        else if(value != 0) {
+            model.rowIndex.push_back(row);
+            model.values.push_back(value);
+        }
+    }
+}
+
+void MpsReader::readRhsOrRange(const std::vector<std::string_view>& fields) {
+    // the name of the RHS/RANGES vector is optional in free MPS
+    uint first = fields.size() % 2;
+    if(fields.size() < 2) fail("an RHS/RANGES entry needs (row, value) pairs");
+
+    for(uint k = first; k + 1 < fields.size(); k += 2) {
+        int row = findRow(fields[k]);
+        double value = parseNumber(fields[k + 1]);
+
+        if(section == MpsSection::RHS) {
+            if(row >= 0) model.rhs[row] = value;
+            else if(fields[k] == objectiveRow) model.objectiveOffset = -value;
+        }
+        else if(row >= 0) model.ranges[row] = value;
+    }
+}
+
+void MpsReader::readBound(const std::vector<std::string_view>& fields) {
+    if(fields.size() < 2) fail("a bound needs a type and a column");
+
+    std::string_view type = fields[0];
+    bool hasValue = (type == "UP" || type == "LO" || type == "FX" || type == "LI" || type == "UI" || type == "SC");
+
+    // the name of the BOUNDS vector is optional in free MPS
+    std::string_view columnName;
+    double value = 0;
+    if(hasValue) {
+        if(fields.size() == 4) columnName = fields[2];
+        else if(fields.size() == 3) columnName = fields[1];
+        else fail("a bound of type " + std::string(type) + " needs a column and a value");
+        value = parseNumber(fields.back());
+        if(value >= MPS_INFINITY) value = INFINITY;
+        else if(value <= -MPS_INFINITY) value = -INFINITY;
+    }
+    else {
+        columnName = (fields.size() >= 3 && columnIndexes.count(fields[2]) != 0) ? fields[2] : fields[1];
+    }
+
+    uint column = findColumn(columnName);
+    double& lower = model.lowerBounds[column];
+    double& upper = model.upperBounds[column];
+
+    if(type == "UP" || type == "UI") {
+        // a negative upper bound on a variable without a lower bound makes it unbounded from below
+        if(value < 0 && lower == 0) lower = -INFINITY;
+        upper = value;
+    }
+    else if(type == "LO" || type == "LI") lower = value;
+    else if(type == "FX") lower = upper = value;
+    else if(type == "FR") {
+        lower = -INFINITY;
+        upper = INFINITY;
+    }
+    else if(type == "MI") lower = -INFINITY;
+    else if(type == "PL") upper = INFINITY;
+    else if(type == "BV") {
+        lower = 0;
+        upper = 1;
+    }
+    else if(type == "SC") fail("semi-continuous variables aren't supported");
+    else fail("invalid bound type " + std::string(type));
+
+    if(type == "LI" || type == "UI" || type == "BV") model.integer[column] = true;
+}
+
+void MpsReader::readColumnPiece(std::string_view piece) {
+    size_t position = 0;
+    while(position < piece.size()) {
+        size_t end = piece.find('\n', position);
+        if(end == std::string_view::npos) end = piece.size();
+        std::string_view currentLine = piece.substr(position, end - position);
+        position = end + 1;
+        line++;
+
+        if(trim(currentLine).empty() || currentLine[0] == '*') continue;
+        readColumn(splitFields(currentLine));
+    }
+}
+
+void MpsReader::readColumnSection(std::string_view columns, uint threads) {
+    uint nPieces = std::max<size_t>(1, std::min<size_t>(threads, columns.size() / PARALLEL_PARSE_MIN_CHUNK));
+    if(nPieces == 1) {
+        readColumnPiece(columns);
+        return;
+    }
+
+    std::vector<std::string_view> pieces = ModelFileReader::splitLines(columns, nPieces);
+    std::vector<std::unique_ptr<MpsReader>> readers;
+    std::vector<std::exception_ptr> errors(pieces.size());
+    std::vector<std::thread> workers;
+
+    // the line breaks of each piece are counted first, so that every piece knows its first line number
+    std::vector<uint> lineCounts(pieces.size());
+    for(uint k = 0; k < pieces.size(); k++) {
+        readers.emplace_back(new MpsReader(format, this));
+        workers.emplace_back([&pieces, &lineCounts, k]() { lineCounts[k] = std::count(pieces[k].begin(), pieces[k].end(), '\n'); });
+    }
+    for(std::thread& worker : workers) worker.join();
+    std::vector<uint> firstLines(pieces.size(), line + 1);
+    for(uint k = 1; k < pieces.size(); k++) firstLines[k] = firstLines[k - 1] + lineCounts[k - 1];
+    for(uint k = 0; k < pieces.size(); k++) readers[k]->line = firstLines[k] - 1;
+
+    workers.clear();
+    for(uint k = 0; k < pieces.size(); k++) {
+        workers.emplace_back([&, k]() {
+            TRACE_THREAD_NAME("parse worker " + std::to_string(k));
+            TRACE_SCOPE("parse piece", "parse", "piece", k, "bytes", pieces[k].size());
+            try {
+                readers[k]->readColumnPiece(pieces[k]);
+            }
+            catch(...) {
+                errors[k] = std::current_exception();
+            }
+        });
+    }
+    for(std::thread& worker : workers) worker.join();
+
+    // --- Append the columns of each piece ---
+    for(uint k = 0; k < pieces.size(); k++) {
+        MpsReader& piece = *readers[k];
+        uint nColumns = piece.model.columnNames.size();
+        std::vector<std::string_view> names(nColumns);
+        for(const std::pair<const std::string_view, uint>& column : piece.columnIndexes) names[column.second] = column.first;
+
+        size_t valueOffset = model.values.size();
+        for(uint c = 0; c < nColumns; c++) {
+            if(c == 0 && !model.columnNames.empty() && model.columnNames.back() == names[c]) {
+                // the piece starts in the middle of the last column read
+                model.objective.back() += piece.model.objective[c];
+                continue;
+            }
+            if(columnIndexes.count(names[c]) != 0) {
+                line = firstLines[k] + std::count(pieces[k].data(), names[c].data(), '\n');
+                fail("the entries of column " + std::string(names[c]) + " aren't contiguous");
+            }
+
+            uint column = model.columnNames.size();
+            columnIndexes[names[c]] = column;
+            model.columnNames.push_back(std::move(piece.model.columnNames[c]));
+            model.columnStart.resize(column + 1, valueOffset + piece.model.columnStart[c]);
+            model.objective.push_back(piece.model.objective[c]);
+            model.lowerBounds.push_back(0);
+            model.upperBounds.push_back(INFINITY);
+            model.integer.push_back((!piece.sawMarker || c < piece.firstMarkedColumn) ? integerMarker : piece.model.integer[c]);
+        }
+        model.rowIndex.insert(model.rowIndex.end(), piece.model.rowIndex.begin(), piece.model.rowIndex.end());
+        model.values.insert(model.values.end(), piece.model.values.begin(), piece.model.values.end());
+        if(piece.sawMarker) integerMarker = piece.integerMarker;
+
+        // the columns of a piece are read before its error, so the first error in the file is reported, as a single threaded parse would
+        if(errors[k]) std::rethrow_exception(errors[k]);
+
+        // the piece's memory is released as soon as it's been appended
+        readers[k].reset();
+    }
+
+    line = firstLines.back() - 1 + lineCounts.back();
+}
+
+// PUBLIC METHODS
+
+SparseModel MpsReader::parse(std::string_view text, MpsFormat format, uint threads) {
+    MpsReader reader(format);
+
+    size_t position = 0;
+    while(position < text.size() && reader.section != MpsSection::ENDATA) {
+        size_t end = text.find('\n', position);
+        if(end == std::string_view::npos) end = text.size();
+        std::string_view currentLine = text.substr(position, end - position);
+        position = end + 1;
+        reader.line++;
+
+        if(trim(currentLine).empty() || currentLine[0] == '*') continue;
+
+        if(currentLine[0] != ' ' && currentLine[0] != '\t') {
+            reader.readHeader(currentLine);
+            if(reader.section == MpsSection::COLUMNS) {
+                // the ROWS section defines every row, so the data lines of the COLUMNS section only depend on the column they're in
+                size_t sectionStart = std::min(position, text.size());
+                size_t sectionEnd = findSectionEnd(text, sectionStart);
+                reader.readColumnSection(text.substr(sectionStart, sectionEnd - sectionStart), threads);
+                position = sectionEnd;
+            }
+            continue;
+        }
+
+        std::vector<std::string_view> fields = reader.splitFields(currentLine);
+        switch(reader.section) {
+            case MpsSection::OBJSENSE:
+                if(fields[0] == "MAX" || fields[0] == "MAXIMIZE") reader.model.type = MAX;
+                else if(fields[0] == "MIN" || fields[0] == "MINIMIZE") reader.model.type = MIN;
+                else reader.fail("invalid objective sense " + std::string(fields[0]));
+                break;
+            case MpsSection::ROWS:
+                reader.readRow(fields);
+                break;
+            case MpsSection::COLUMNS:
+                reader.readColumn(fields);
+                break;
+            case MpsSection::RHS:
+            case MpsSection::RANGES:
+                reader.readRhsOrRange(fields);
+                break;
+            case MpsSection::BOUNDS:
+                reader.readBound(fields);
+                break;
+            default:
+                reader.fail("data outside of a section");
+        }
+    }
+
+    if(reader.objectiveRow.empty()) reader.fail("the model has no objective function(N) row");
+
+    reader.model.columnStart.resize(reader.model.columnNames.size() + 1, reader.model.values.size());
+    return reader.model;
+}
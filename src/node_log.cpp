@@ -0,0 +1,139 @@
+#include "node_log.h"
+#include "buffered_writer.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+// fill colors of the DOT nodes, by NodeFate
+const char* FATE_COLORS[] = {"white", "lightyellow", "lightblue", "palegreen", "lightcoral", "orange", "lightgray"};
+static_assert(sizeof(FATE_COLORS) / sizeof(FATE_COLORS[0]) == NODE_PRUNED + 1, "every NodeFate needs a color");
+
+}
+
+std::string convertNodeFateToString(NodeFate fate) {
+    switch(fate) {
+        case NODE_UNSOLVED: return "unsolved";
+        case NODE_OPEN: return "open";
+        case NODE_BRANCHED: return "branched";
+        case NODE_INTEGRAL: return "integral";
+        case NODE_INFEASIBLE: return "infeasible";
+        case NODE_UNBOUNDED: return "unbounded";
+        case NODE_PRUNED: return "pruned";
+        default: return "";
+    }
+}
+
+NodeRecord NodeLog::newRecord(uint32_t id, uint32_t parent, uint32_t depth, NodeDirection direction) {
+    NodeRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.id = id;
+    record.parent = parent;
+    record.depth = depth;
+    record.branchVariable = -1;
+    record.bound = NAN;
+    record.fate = NODE_UNSOLVED;
+    record.direction = direction;
+    return record;
+}
+
+void NodeLog::write(const std::vector<NodeRecord>& records, const std::string& fileName) {
+    NodeLogHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, NODE_LOG_MAGIC, sizeof(NODE_LOG_MAGIC));
+    header.version = NODE_LOG_VERSION;
+    header.recordSize = sizeof(NodeRecord);
+    header.nRecords = records.size();
+
+    BufferedWriter writer(fileName);
+    writer << std::string_view((const char*)&header, sizeof(header));
+    writer << std::string_view((const char*)records.data(), records.size() * sizeof(NodeRecord));
+    writer.close();
+}
+
+std::vector<NodeRecord> NodeLog::read(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if(!file) throw std::invalid_argument("Node log does not exist: " + fileName);
+
+    NodeLogHeader header;
+    if(!file.read((char*)&header, sizeof(header)) || std::memcmp(header.magic, NODE_LOG_MAGIC, sizeof(NODE_LOG_MAGIC)) != 0) {
+        throw std::invalid_argument("Not a node log: " + fileName);
+    }
+    if(header.version != NODE_LOG_VERSION || header.recordSize != sizeof(NodeRecord)) {
+        std::ostringstream errorMsg;
+        errorMsg << "Node log " << fileName << " was written by version " << header.version << ", expected version " << NODE_LOG_VERSION;
+        throw std::invalid_argument(errorMsg.str());
+    }
+
+    // the record count is checked against the file size before anything is allocated for it
+    std::streamoff recordsStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t recordBytes = file.tellg() - recordsStart;
+    file.seekg(recordsStart);
+    if(header.nRecords > recordBytes / sizeof(NodeRecord)) throw std::invalid_argument("Node log is truncated: " + fileName);
+
+    std::vector<NodeRecord> records(header.nRecords);
+    if(!file.read((char*)records.data(), records.size() * sizeof(NodeRecord))) throw std::invalid_argument("Node log is truncated: " + fileName);
+
+    for(uint64_t i = 0; i < records.size(); i++) {
+        if(records[i].fate > NODE_PRUNED || records[i].direction > NODE_RIGHT) {
+            std::ostringstream errorMsg;
+            errorMsg << "Node log " << fileName << " is corrupt: record " << i << " has fate " << (uint)records[i].fate << " and direction " << (uint)records[i].direction;
+            throw std::invalid_argument(errorMsg.str());
+        }
+    }
+    return records;
+}
+
+void NodeLog::writeDot(const std::vector<NodeRecord>& records, const std::string& fileName) {
+    BufferedWriter writer(fileName);
+    writer << "digraph tree {\n  node [shape=box, style=filled, fontname=monospace];\n";
+
+    for(const NodeRecord& record : records) {
+        writer << "  n" << record.id << " [fillcolor=" << FATE_COLORS[record.fate] << ", label=\"#" << record.id << " " << convertNodeFateToString((NodeFate)record.fate);
+        if(!std::isnan(record.bound)) writer << "\\nbound " << record.bound;
+        writer << "\\n" << record.lpIterations << " it, " << record.solveTime << " ms";
+        if(record.fractionalCount > 0) writer << "\\n" << record.fractionalCount << " fractional";
+        writer << "\"];\n";
+
+        if(record.parent == NODE_LOG_NO_PARENT || record.parent >= records.size()) continue;
+        const NodeRecord& parent = records[record.parent];
+        writer << "  n" << record.parent << " -> n" << record.id << " [label=\"x" << (uint)(parent.branchVariable + 1);
+        if(record.direction == NODE_LEFT) writer << " <= " << std::floor(parent.branchValue);
+        else writer << " >= " << std::ceil(parent.branchValue);
+        writer << "\"];\n";
+    }
+
+    writer << "}\n";
+    writer.close();
+}
+
+void NodeLog::writeJson(const std::vector<NodeRecord>& records, const std::string& fileName) {
+    BufferedWriter writer(fileName);
+    writer << "{\n  \"version\": " << (uint)NODE_LOG_VERSION << ",\n  \"nodes\": [";
+
+    for(uint i = 0; i < records.size(); i++) {
+        const NodeRecord& record = records[i];
+        writer << (i == 0 ? "\n" : ",\n") << "    {\"id\": " << record.id << ", \"parent\": ";
+        if(record.parent == NODE_LOG_NO_PARENT) writer << "null";
+        else writer << record.parent;
+        writer << ", \"depth\": " << record.depth << ", \"direction\": ";
+        writer << (record.direction == NODE_ROOT ? "\"root\"" : record.direction == NODE_LEFT ? "\"left\"" : "\"right\"");
+        writer << ", \"fate\": \"" << convertNodeFateToString((NodeFate)record.fate) << "\", \"bound\": ";
+        if(std::isnan(record.bound)) writer << "null";
+        else writer << record.bound;
+        writer << ", \"lp_iterations\": " << record.lpIterations << ", \"solve_time_ms\": " << record.solveTime;
+        writer << ", \"fractional\": " << record.fractionalCount << ", \"branch_variable\": ";
+        if(record.branchVariable < 0) writer << "null, \"branch_value\": null";
+        else writer << (uint)record.branchVariable << ", \"branch_value\": " << record.branchValue;
+        writer << "}";
+    }
+
+    writer << "\n  ]\n}\n";
+    writer.close();
+}
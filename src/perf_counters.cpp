@@ -0,0 +1,126 @@
+#include "perf_counters.h"
+
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+namespace {
+
+// (type, config) of each PerfEvent
+const uint32_t EVENT_TYPES[N_PERF_EVENTS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+const uint64_t EVENT_CONFIGS[N_PERF_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                                               PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_SW_PAGE_FAULTS};
+
+// glibc has no wrapper for perf_event_open
+int openEvent(PerfEvent event) {
+    struct perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = EVENT_TYPES[event];
+    attributes.config = EVENT_CONFIGS[event];
+    attributes.disabled = 1;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+}
+
+PerfCounts emptyPerfCounts() {
+    PerfCounts counts;
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        counts.counts[i] = 0;
+        counts.available[i] = false;
+    }
+    return counts;
+}
+
+bool hasPerfCounts(const PerfCounts& counts) {
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        if(counts.available[i]) return true;
+    }
+    return false;
+}
+
+void addPerfCounts(PerfCounts& total, const PerfCounts& counts) {
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        if(!counts.available[i]) continue;
+        total.counts[i] += counts.counts[i];
+        total.available[i] = true;
+    }
+}
+
+std::string convertPerfEventToString(PerfEvent event) {
+    switch(event) {
+        case PERF_CYCLES: return "cycles";
+        case PERF_INSTRUCTIONS: return "instructions";
+        case PERF_CACHE_MISSES: return "cache_misses";
+        case PERF_BRANCH_MISSES: return "branch_misses";
+        case PERF_PAGE_FAULTS: return "page_faults";
+        default: return "";
+    }
+}
+
+PerfCounters::PerfCounters() {
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        descriptors[i] = openEvent((PerfEvent)i);
+        if(descriptors[i] < 0 && error.empty()) {
+            if(errno == ENOENT || errno == EOPNOTSUPP) error = convertPerfEventToString((PerfEvent)i) + ": not supported by this system";
+            else error = convertPerfEventToString((PerfEvent)i) + ": " + std::strerror(errno);
+            if(errno == EACCES || errno == EPERM) error += "(see /proc/sys/kernel/perf_event_paranoid)";
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        if(descriptors[i] >= 0) close(descriptors[i]);
+    }
+}
+
+bool PerfCounters::isAvailable() {
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        if(descriptors[i] >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+    // resetting a counter doesn't reset what its ended child threads counted, so the counts are measured from the current readings instead
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        startReadings[i] = {0, 0, 0};
+        if(descriptors[i] < 0) continue;
+        if(read(descriptors[i], &startReadings[i], sizeof(CounterReading)) != (ssize_t)sizeof(CounterReading)) startReadings[i] = {0, 0, 0};
+        ioctl(descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfCounts PerfCounters::stop() {
+    PerfCounts counts = emptyPerfCounts();
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        if(descriptors[i] >= 0) ioctl(descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for(uint i = 0; i < N_PERF_EVENTS; i++) {
+        CounterReading reading;
+        if(descriptors[i] < 0 || read(descriptors[i], &reading, sizeof(reading)) != (ssize_t)sizeof(reading)) continue;
+        reading.value -= startReadings[i].value;
+        reading.timeEnabled -= startReadings[i].timeEnabled;
+        reading.timeRunning -= startReadings[i].timeRunning;
+
+        // the event never got onto the PMU(e.g. too many events), so nothing was counted
+        if(reading.timeEnabled > 0 && reading.timeRunning == 0) continue;
+
+        counts.counts[i] = reading.value;
+        if(reading.timeRunning < reading.timeEnabled) counts.counts[i] = (uint64_t)((double)reading.value * reading.timeEnabled / reading.timeRunning);
+        counts.available[i] = true;
+    }
+    return counts;
+}
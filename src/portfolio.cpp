@@ -0,0 +1,80 @@
+#include "portfolio.h"
+#include "trace.h"
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// PUBLIC METHODS
+
+Portfolio::Portfolio(LpProblem initialProblem, std::vector<std::pair<ExplorationStrategy, BranchingStrategy>> portfolioStrategies) {
+    if(portfolioStrategies.empty()) {
+        throw std::invalid_argument("A portfolio needs at least one pair of strategies");
+    }
+
+    problem = initialProblem;
+    strategies = portfolioStrategies;
+    scaling = true;
+    rootAlgorithm = SIMPLEX;
+    crossover = true;
+    concurrentRoot = false;
+    winner = 0;
+}
+
+std::vector<std::pair<ExplorationStrategy, BranchingStrategy>> Portfolio::defaultStrategies(std::pair<ExplorationStrategy, BranchingStrategy> first, uint size) {
+    std::vector<std::pair<ExplorationStrategy, BranchingStrategy>> result = {first};
+
+    for(ExplorationStrategy explorStrat : getPossibleExplorationStrategies()) {
+        if(explorStrat == ExplorationStrategy::EXPLORE_ALL_NODES) continue;
+        for(BranchingStrategy branchStrat : getPossibleBranchingStrategies()) {
+            if(result.size() >= size) return result;
+
+            std::pair<ExplorationStrategy, BranchingStrategy> current = std::make_pair(explorStrat, branchStrat);
+            if(std::find(result.begin(), result.end(), current) == result.end()) result.push_back(current);
+        }
+    }
+
+    return result;
+}
+
+Matrix Portfolio::solve() {
+    incumbent = std::make_shared<SharedIncumbent>(problem.getType());
+
+    trees.clear();
+    for(uint i = 0; i < strategies.size(); i++) {
+        trees.push_back(BaBTree(problem));
+        trees.back().setScaling(scaling);
+        trees.back().setRootAlgorithm(rootAlgorithm, crossover);
+        trees.back().setConcurrentRoot(concurrentRoot);
+        trees.back().setSharedIncumbent(incumbent);
+    }
+
+    std::atomic<int> firstFinished(-1);
+    std::vector<std::thread> threads;
+    for(uint i = 0; i < strategies.size(); i++) {
+        threads.push_back(std::thread([this, &firstFinished, i]() {
+            TRACE_THREAD_NAME("portfolio " + convertExplorStratToString(strategies[i].first) + " " + convertBranchStratToString(strategies[i].second));
+            trees[i].solveTree(strategies[i].first, strategies[i].second);
+
+            // the first tree to finish its search stops the others
+            int expected = -1;
+            if(firstFinished.compare_exchange_strong(expected, (int)i)) incumbent->stop();
+        }));
+    }
+    for(std::thread& thread : threads) thread.join();
+
+    winner = firstFinished;
+    return trees[winner].getMetrics().optimalWholeSolution;
+}
+
+void Portfolio::displayProblem(Matrix optimalWholeSolution) {
+    std::cout << "Winning strategies: " << convertExplorStratToString(strategies[winner].first) << ", "
+              << convertBranchStratToString(strategies[winner].second) << " (out of " << strategies.size() << ")" << std::endl;
+    trees[winner].displayProblem(optimalWholeSolution);
+}
+
+void Portfolio::deleteTrees() {
+    for(BaBTree& tree : trees) tree.deleteTree();
+}
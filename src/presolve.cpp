@@ -0,0 +1,707 @@
+#include "presolve.h"
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+
+#define PRESOLVE_TOLERANCE 1e-9
+
+namespace {
+
+bool isTighter(double newBound, double oldBound, bool isUpper) {
+    if(std::isinf(newBound)) return false;
+    double margin = 1e-7 * std::max(1.0, std::fabs(newBound));
+    return isUpper ? newBound < oldBound - margin : newBound > oldBound + margin;
+}
+
+uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    // 64 bit variant of boost::hash_combine
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 12) + (seed >> 4));
+}
+
+uint64_t hashDouble(double value) {
+    if(value == 0) value = 0; // -0.0 and 0.0 must hash the same
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+}
+
+// POSTSOLVE STACK
+
+PostsolveStack::PostsolveStack(void) : PostsolveStack(0) {}
+
+PostsolveStack::PostsolveStack(uint originalColumns) {
+    nOriginalColumns = originalColumns;
+    objectiveOffset = 0;
+}
+
+void PostsolveStack::push(const PostsolveStep& step) {
+    steps.push_back(step);
+}
+
+void PostsolveStack::setColumnMap(const std::vector<uint>& map, const std::vector<double>& offsets) {
+    reducedToOriginal = map;
+    columnOffsets = offsets;
+}
+
+std::vector<double> PostsolveStack::postsolve(const std::vector<double>& reducedSolution) const {
+    if(reducedSolution.size() != reducedToOriginal.size()) {
+        std::ostringstream errorMsg;
+        errorMsg << "Error using postsolve: the reduced model has " << reducedToOriginal.size()
+                 << " variables, but the solution provided has " << reducedSolution.size();
+        throw std::invalid_argument(errorMsg.str());
+    }
+
+    std::vector<double> solution(nOriginalColumns, 0.0);
+    for(uint i = 0; i < reducedToOriginal.size(); i++) {
+        solution[reducedToOriginal[i]] = reducedSolution[i] + columnOffsets[i];
+    }
+
+    for(auto it = steps.rbegin(); it != steps.rend(); it++) {
+        const PostsolveStep& step = *it;
+        if(step.type == FIXED_COLUMN) {
+            solution[step.column] = step.value;
+        }
+        else if(step.type == MERGED_COLUMNS) {
+            // value is the lower bound of the removed column, bound is the upper bound of the kept column
+            double mergedValue = solution[step.column];
+            solution[step.column] = std::min(step.bound, mergedValue - step.value);
+            solution[step.otherColumn] = mergedValue - solution[step.column];
+        }
+        else if(step.type == SUBSTITUTED_COLUMN) {
+            double activity = 0;
+            for(const std::pair<uint, double>& entry : step.rowEntries) activity += entry.second * solution[entry.first];
+            solution[step.column] = (step.value - activity) / step.bound;
+        }
+    }
+
+    return solution;
+}
+
+// PRIVATE METHODS
+
+void Presolver::buildFromProblem(LpProblem& problem, bool integerVariables) {
+    type = problem.getType();
+    objectiveSign = (type == MAX) ? -1.0 : 1.0;
+
+    Matrix& objectiveFunction = problem.getObjectiveFunction();
+    std::vector<Constraint>& constraints = problem.getConstraints();
+
+    nColumns = objectiveFunction.getNColumns();
+    nRows = constraints.size();
+
+    cost.resize(nColumns);
+    for(uint j = 0; j < nColumns; j++) cost[j] = objectiveSign * objectiveFunction.getElement(0, j);
+
+    colLower = problem.getLowerBounds();
+    colUpper = problem.getUpperBounds();
+    impliedLower = colLower;
+    impliedUpper = colUpper;
+    colActive.assign(nColumns, true);
+    colInteger.assign(nColumns, integerVariables);
+    columns.assign(nColumns, {});
+
+    rows.assign(nRows, {});
+    rowLower.assign(nRows, -INFINITY);
+    rowUpper.assign(nRows, INFINITY);
+    rowActive.assign(nRows, true);
+
+    for(uint i = 0; i < nRows; i++) {
+        std::vector<double>& lhs = constraints[i].getLhs();
+        for(uint j = 0; j < lhs.size() && j < nColumns; j++) {
+            if(lhs[j] == 0) continue;
+            rows[i].emplace_back(j, lhs[j]);
+            columns[j].push_back(i);
+        }
+
+        double rhs = constraints[i].getRhs();
+        ConstraintType constraintType = constraints[i].getType();
+        if(constraintType == LESS_THAN_OR_EQUAL || constraintType == EQUAL) rowUpper[i] = rhs;
+        if(constraintType == GREATER_THAN_OR_EQUAL || constraintType == EQUAL) rowLower[i] = rhs;
+    }
+}
+
+double Presolver::getCoefficient(uint row, uint column) {
+    std::vector<std::pair<uint, double>>& entries = rows[row];
+    auto it = std::lower_bound(entries.begin(), entries.end(), column, [](const std::pair<uint, double>& entry, uint col) {
+        return entry.first < col;
+    });
+    if(it == entries.end() || it->first != column) return 0;
+    return it->second;
+}
+
+void Presolver::eraseEntry(uint row, uint column) {
+    std::vector<std::pair<uint, double>>& entries = rows[row];
+    auto it = std::lower_bound(entries.begin(), entries.end(), column, [](const std::pair<uint, double>& entry, uint col) {
+        return entry.first < col;
+    });
+    if(it != entries.end() && it->first == column) entries.erase(it);
+}
+
+uint Presolver::compactColumn(uint column) {
+    std::vector<uint>& colRows = columns[column];
+    colRows.erase(std::remove_if(colRows.begin(), colRows.end(), [&](uint row) {
+        return !rowActive[row] || getCoefficient(row, column) == 0;
+    }), colRows.end());
+    return colRows.size();
+}
+
+void Presolver::removeRow(uint row) {
+    rowActive[row] = false;
+    rows[row].clear();
+    rows[row].shrink_to_fit();
+    stats.removedRows++;
+}
+
+void Presolver::fixColumn(uint column, double value) {
+    for(uint row : columns[column]) {
+        if(!rowActive[row]) continue;
+        double coefficient = getCoefficient(row, column);
+        if(coefficient == 0) continue;
+
+        rowLower[row] -= coefficient * value;
+        rowUpper[row] -= coefficient * value;
+        eraseEntry(row, column);
+    }
+    columns[column].clear();
+
+    postsolveStack.addObjectiveOffset(objectiveSign * cost[column] * value);
+
+    PostsolveStep step;
+    step.type = FIXED_COLUMN;
+    step.column = column;
+    step.otherColumn = column;
+    step.value = value;
+    step.bound = 0;
+    postsolveStack.push(step);
+
+    colActive[column] = false;
+    stats.removedColumns++;
+}
+
+bool Presolver::tightenColumnBounds(uint column, double lower, double upper, bool modelBound) {
+    if(colInteger[column]) {
+        lower = std::ceil(lower - PRESOLVE_TOLERANCE);
+        upper = std::floor(upper + PRESOLVE_TOLERANCE);
+    }
+
+    bool tightened = false;
+    if(isTighter(lower, impliedLower[column], false)) {
+        impliedLower[column] = lower;
+        tightened = true;
+    }
+    if(isTighter(upper, impliedUpper[column], true)) {
+        impliedUpper[column] = upper;
+        tightened = true;
+    }
+    if(modelBound) {
+        colLower[column] = std::max(colLower[column], lower);
+        colUpper[column] = std::min(colUpper[column], upper);
+    }
+
+    if(impliedLower[column] > impliedUpper[column] + PRESOLVE_TOLERANCE) infeasible = true;
+    else if(impliedLower[column] > impliedUpper[column]) impliedUpper[column] = impliedLower[column];
+
+    if(tightened) stats.tightenedBounds++;
+    return tightened;
+}
+
+bool Presolver::removeEmptyAndSingletonRows() {
+    bool changed = false;
+
+    for(uint i = 0; i < nRows && !infeasible; i++) {
+        if(!rowActive[i]) continue;
+
+        if(rows[i].empty()) {
+            if(rowLower[i] > PRESOLVE_TOLERANCE || rowUpper[i] < -PRESOLVE_TOLERANCE) infeasible = true;
+            removeRow(i);
+            changed = true;
+        }
+        else if(rows[i].size() == 1) {
+            uint column = rows[i][0].first;
+            double coefficient = rows[i][0].second;
+
+            double lower = (coefficient > 0) ? rowLower[i] / coefficient : rowUpper[i] / coefficient;
+            double upper = (coefficient > 0) ? rowUpper[i] / coefficient : rowLower[i] / coefficient;
+
+            tightenColumnBounds(column, lower, upper, true);
+            removeRow(i);
+            stats.singletonRows++;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+bool Presolver::removeDuplicateRows() {
+    bool changed = false;
+    std::unordered_map<uint64_t, std::vector<uint>> buckets;
+    buckets.reserve(nRows);
+
+    for(uint i = 0; i < nRows && !infeasible; i++) {
+        if(!rowActive[i] || rows[i].size() < 2) continue;
+
+        // normalize the row so that its first coefficient is 1
+        double scale = rows[i][0].second;
+        uint64_t hash = rows[i].size();
+        for(const std::pair<uint, double>& entry : rows[i]) {
+            hash = hashCombine(hash, entry.first);
+            hash = hashCombine(hash, hashDouble(entry.second / scale));
+        }
+
+        std::vector<uint>& bucket = buckets[hash];
+        bool merged = false;
+        for(uint k : bucket) {
+            if(!rowActive[k] || rows[k].size() != rows[i].size()) continue;
+
+            double otherScale = rows[k][0].second;
+            bool parallel = true;
+            for(uint e = 0; e < rows[i].size() && parallel; e++) {
+                parallel = rows[i][e].first == rows[k][e].first && rows[i][e].second / scale == rows[k][e].second / otherScale;
+            }
+            if(!parallel) continue;
+
+            // row i = ratio * row k
+            double ratio = scale / otherScale;
+            double lower = (ratio > 0) ? rowLower[i] / ratio : rowUpper[i] / ratio;
+            double upper = (ratio > 0) ? rowUpper[i] / ratio : rowLower[i] / ratio;
+
+            rowLower[k] = std::max(rowLower[k], lower);
+            rowUpper[k] = std::min(rowUpper[k], upper);
+            if(rowLower[k] > rowUpper[k] + PRESOLVE_TOLERANCE) infeasible = true;
+            else if(rowUpper[k] - rowLower[k] <= PRESOLVE_TOLERANCE) rowUpper[k] = rowLower[k];
+
+            removeRow(i);
+            stats.duplicateRows++;
+            merged = true;
+            changed = true;
+            break;
+        }
+
+        if(!merged) bucket.push_back(i);
+    }
+
+    return changed;
+}
+
+bool Presolver::tightenBounds() {
+    bool changed = false;
+
+    for(uint i = 0; i < nRows && !infeasible; i++) {
+        if(!rowActive[i] || rows[i].size() < 2) continue;
+
+        // activity bounds using the implied bounds(minimum/maximum) and the model bounds(only used to detect redundancy)
+        double minActivity = 0, maxActivity = 0, modelMinActivity = 0, modelMaxActivity = 0;
+        uint minInfinite = 0, maxInfinite = 0, modelMinInfinite = 0, modelMaxInfinite = 0;
+
+        for(const std::pair<uint, double>& entry : rows[i]) {
+            uint j = entry.first;
+            double a = entry.second;
+            double minBound = (a > 0) ? impliedLower[j] : impliedUpper[j];
+            double maxBound = (a > 0) ? impliedUpper[j] : impliedLower[j];
+            double modelMinBound = (a > 0) ? colLower[j] : colUpper[j];
+            double modelMaxBound = (a > 0) ? colUpper[j] : colLower[j];
+
+            if(std::isinf(minBound)) minInfinite++; else minActivity += a * minBound;
+            if(std::isinf(maxBound)) maxInfinite++; else maxActivity += a * maxBound;
+            if(std::isinf(modelMinBound)) modelMinInfinite++; else modelMinActivity += a * modelMinBound;
+            if(std::isinf(modelMaxBound)) modelMaxInfinite++; else modelMaxActivity += a * modelMaxBound;
+        }
+
+        double tolerance = PRESOLVE_TOLERANCE * std::max(1.0, std::max(std::fabs(minActivity), std::fabs(maxActivity)));
+
+        if((minInfinite == 0 && minActivity > rowUpper[i] + tolerance) || (maxInfinite == 0 && maxActivity < rowLower[i] - tolerance)) {
+            infeasible = true;
+            break;
+        }
+
+        // redundant row: it can never be violated while the variables respect the model bounds
+        bool lowerRedundant = std::isinf(rowLower[i]) || (modelMinInfinite == 0 && modelMinActivity >= rowLower[i] - tolerance);
+        bool upperRedundant = std::isinf(rowUpper[i]) || (modelMaxInfinite == 0 && modelMaxActivity <= rowUpper[i] + tolerance);
+        if(lowerRedundant && upperRedundant) {
+            removeRow(i);
+            changed = true;
+            continue;
+        }
+
+        // forcing row: the only way to satisfy it is to set every variable to the bound that minimizes/maximizes the activity
+        bool forcedToMin = !std::isinf(rowUpper[i]) && minInfinite == 0 && minActivity >= rowUpper[i] - tolerance;
+        bool forcedToMax = !std::isinf(rowLower[i]) && maxInfinite == 0 && maxActivity <= rowLower[i] + tolerance;
+        if(forcedToMin || forcedToMax) {
+            std::vector<std::pair<uint, double>> entries = rows[i];
+            for(const std::pair<uint, double>& entry : entries) {
+                uint j = entry.first;
+                bool atLower = (entry.second > 0) == forcedToMin;
+                fixColumn(j, atLower ? impliedLower[j] : impliedUpper[j]);
+            }
+            removeRow(i);
+            changed = true;
+            continue;
+        }
+
+        for(const std::pair<uint, double>& entry : rows[i]) {
+            uint j = entry.first;
+            double a = entry.second;
+            double lower = -INFINITY, upper = INFINITY;
+
+            if(!std::isinf(rowUpper[i])) {
+                double minBound = (a > 0) ? impliedLower[j] : impliedUpper[j];
+                double residual = INFINITY;
+                if(std::isinf(minBound) && minInfinite == 1) residual = minActivity;
+                else if(!std::isinf(minBound) && minInfinite == 0) residual = minActivity - a * minBound;
+
+                if(!std::isinf(residual)) {
+                    if(a > 0) upper = (rowUpper[i] - residual) / a;
+                    else lower = (rowUpper[i] - residual) / a;
+                }
+            }
+            if(!std::isinf(rowLower[i])) {
+                double maxBound = (a > 0) ? impliedUpper[j] : impliedLower[j];
+                double residual = INFINITY;
+                if(std::isinf(maxBound) && maxInfinite == 1) residual = maxActivity;
+                else if(!std::isinf(maxBound) && maxInfinite == 0) residual = maxActivity - a * maxBound;
+
+                if(!std::isinf(residual)) {
+                    if(a > 0) lower = std::max(lower, (rowLower[i] - residual) / a);
+                    else upper = std::min(upper, (rowLower[i] - residual) / a);
+                }
+            }
+
+            if(tightenColumnBounds(j, lower, upper, false)) changed = true;
+            if(infeasible) break;
+        }
+    }
+
+    return changed;
+}
+
+bool Presolver::removeFixedAndDominatedColumns() {
+    bool changed = false;
+
+    for(uint j = 0; j < nColumns && !infeasible; j++) {
+        if(!colActive[j]) continue;
+
+        if(impliedUpper[j] - impliedLower[j] <= PRESOLVE_TOLERANCE) {
+            fixColumn(j, impliedLower[j]);
+            changed = true;
+            continue;
+        }
+
+        // the direction in which the variable can move without making any row harder to satisfy
+        bool decreaseHelps = cost[j] >= 0;
+        bool increaseHelps = cost[j] <= 0;
+        for(uint row : columns[j]) {
+            if(!rowActive[row]) continue;
+            double a = getCoefficient(row, j);
+            if(a == 0) continue;
+
+            bool upperFinite = !std::isinf(rowUpper[row]);
+            bool lowerFinite = !std::isinf(rowLower[row]);
+            if((a > 0 && lowerFinite) || (a < 0 && upperFinite)) decreaseHelps = false;
+            if((a > 0 && upperFinite) || (a < 0 && lowerFinite)) increaseHelps = false;
+            if(!decreaseHelps && !increaseHelps) break;
+        }
+
+        if(decreaseHelps) {
+            fixColumn(j, impliedLower[j]);
+            stats.dominatedColumns++;
+            changed = true;
+        }
+        else if(increaseHelps && !std::isinf(impliedUpper[j])) {
+            fixColumn(j, impliedUpper[j]);
+            stats.dominatedColumns++;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+bool Presolver::tightenCoefficients() {
+    bool changed = false;
+
+    for(uint i = 0; i < nRows; i++) {
+        if(!rowActive[i] || rows[i].size() < 2) continue;
+
+        // only one sided rows, written as sign * a * x <= b
+        double sign;
+        if(std::isinf(rowLower[i]) && !std::isinf(rowUpper[i])) sign = 1;
+        else if(!std::isinf(rowLower[i]) && std::isinf(rowUpper[i])) sign = -1;
+        else continue;
+
+        double b = (sign > 0) ? rowUpper[i] : -rowLower[i];
+        double maxActivity = 0;
+        bool finiteActivity = true;
+        for(const std::pair<uint, double>& entry : rows[i]) {
+            double a = sign * entry.second;
+            double bound = (a > 0) ? colUpper[entry.first] : colLower[entry.first];
+            if(std::isinf(bound)) {
+                finiteActivity = false;
+                break;
+            }
+            maxActivity += a * bound;
+        }
+        if(!finiteActivity || maxActivity <= b) continue;
+
+        for(std::pair<uint, double>& entry : rows[i]) {
+            uint j = entry.first;
+            if(!colInteger[j] || colLower[j] != 0 || colUpper[j] != 1) continue;
+
+            double a = sign * entry.second;
+            double tolerance = PRESOLVE_TOLERANCE * std::max(1.0, std::fabs(b));
+            if(a > 0) {
+                // the row is redundant when x[j] = 0, so its coefficient and the rhs can both be reduced by d
+                double d = b - (maxActivity - a);
+                if(d > tolerance && a > d + tolerance) {
+                    entry.second = sign * (a - d);
+                    b -= d;
+                    maxActivity -= d;
+                    stats.tightenedCoefficients++;
+                    changed = true;
+                }
+            }
+            else {
+                // the row is redundant when x[j] = 1
+                if(maxActivity + a < b - tolerance && b < maxActivity - tolerance) {
+                    entry.second = sign * (b - maxActivity);
+                    stats.tightenedCoefficients++;
+                    changed = true;
+                }
+            }
+        }
+
+        if(sign > 0) rowUpper[i] = b;
+        else rowLower[i] = -b;
+    }
+
+    return changed;
+}
+
+bool Presolver::substituteSingletonColumns() {
+    bool changed = false;
+
+    for(uint j = 0; j < nColumns; j++) {
+        if(!colActive[j] || compactColumn(j) != 1) continue;
+
+        uint row = columns[j][0];
+        if(rowLower[row] != rowUpper[row] || rows[row].size() < 2) continue;
+
+        double a = getCoefficient(row, j);
+        double rhs = rowUpper[row];
+
+        // integer variables can only be substituted if they are integer whenever the rest of the row is
+        if(colInteger[j]) {
+            bool integral = std::fabs(a) == 1 && rhs == std::round(rhs);
+            for(const std::pair<uint, double>& entry : rows[row]) {
+                if(!integral) break;
+                if(entry.first == j) continue;
+                integral = colInteger[entry.first] && entry.second == std::round(entry.second);
+            }
+            if(!integral) continue;
+        }
+
+        PostsolveStep step;
+        step.type = SUBSTITUTED_COLUMN;
+        step.column = j;
+        step.otherColumn = j;
+        step.value = rhs;
+        step.bound = a;
+        for(const std::pair<uint, double>& entry : rows[row]) {
+            if(entry.first == j) continue;
+            step.rowEntries.push_back(entry);
+            cost[entry.first] -= cost[j] * entry.second / a;
+        }
+        postsolveStack.push(step);
+        postsolveStack.addObjectiveOffset(objectiveSign * cost[j] * rhs / a);
+
+        // the bounds of x[j] become the bounds of the rest of the row
+        double lower = (a > 0) ? rhs - a * colUpper[j] : rhs - a * colLower[j];
+        double upper = (a > 0) ? rhs - a * colLower[j] : rhs - a * colUpper[j];
+        rowLower[row] = lower;
+        rowUpper[row] = upper;
+        eraseEntry(row, j);
+        columns[j].clear();
+
+        colActive[j] = false;
+        stats.removedColumns++;
+        stats.substitutedColumns++;
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool Presolver::removeDuplicateColumns() {
+    bool changed = false;
+
+    std::vector<std::vector<std::pair<uint, double>>> columnEntries(nColumns);
+    for(uint i = 0; i < nRows; i++) {
+        if(!rowActive[i]) continue;
+        for(const std::pair<uint, double>& entry : rows[i]) columnEntries[entry.first].emplace_back(i, entry.second);
+    }
+
+    std::unordered_map<uint64_t, std::vector<uint>> buckets;
+    buckets.reserve(nColumns);
+
+    for(uint j = 0; j < nColumns; j++) {
+        if(!colActive[j] || columnEntries[j].empty()) continue;
+
+        uint64_t hash = hashCombine(columnEntries[j].size(), hashDouble(cost[j]));
+        hash = hashCombine(hash, colInteger[j]);
+        for(const std::pair<uint, double>& entry : columnEntries[j]) {
+            hash = hashCombine(hash, entry.first);
+            hash = hashCombine(hash, hashDouble(entry.second));
+        }
+
+        std::vector<uint>& bucket = buckets[hash];
+        bool merged = false;
+        for(uint k : bucket) {
+            if(cost[k] != cost[j] || colInteger[k] != colInteger[j] || columnEntries[k] != columnEntries[j]) continue;
+
+            // x[k] and x[j] always appear together, so they are replaced by y = x[k] + x[j], stored in x[k]
+            PostsolveStep step;
+            step.type = MERGED_COLUMNS;
+            step.column = k;
+            step.otherColumn = j;
+            step.value = colLower[j];
+            step.bound = colUpper[k];
+            postsolveStack.push(step);
+
+            colLower[k] += colLower[j];
+            colUpper[k] += colUpper[j];
+            impliedLower[k] += impliedLower[j];
+            impliedUpper[k] += impliedUpper[j];
+
+            for(const std::pair<uint, double>& entry : columnEntries[j]) eraseEntry(entry.first, j);
+            columns[j].clear();
+            colActive[j] = false;
+
+            stats.removedColumns++;
+            stats.duplicateColumns++;
+            merged = true;
+            changed = true;
+            break;
+        }
+
+        if(!merged) bucket.push_back(j);
+    }
+
+    return changed;
+}
+
+void Presolver::finalizeColumns() {
+    std::vector<uint> map;
+    std::vector<double> offsets;
+
+    for(uint j = 0; j < nColumns; j++) {
+        if(!colActive[j]) continue;
+        map.push_back(j);
+        offsets.push_back(impliedLower[j]);
+        postsolveStack.addObjectiveOffset(objectiveSign * cost[j] * impliedLower[j]);
+    }
+
+    postsolveStack.setColumnMap(map, offsets);
+}
+
+// PUBLIC METHODS
+
+Presolver::Presolver(LpProblem& problem, bool integerVariables) : postsolveStack(problem.getObjectiveFunction().getNColumns()) {
+    stats = PresolveStats{};
+    infeasible = false;
+    // the model's own constant term is carried like the ones reductions add, so every reduced objective value maps to the original one
+    postsolveStack.addObjectiveOffset(problem.getObjectiveOffset());
+    buildFromProblem(problem, integerVariables);
+}
+
+ProblemStatus Presolver::presolve() {
+    bool changed = true;
+    for(uint round = 0; changed && round < MAX_PRESOLVE_ROUNDS && !infeasible; round++) {
+        changed = false;
+        if(removeEmptyAndSingletonRows()) changed = true;
+        if(!infeasible && removeDuplicateRows()) changed = true;
+        if(!infeasible && tightenBounds()) changed = true;
+        if(!infeasible && removeFixedAndDominatedColumns()) changed = true;
+        if(!infeasible && tightenCoefficients()) changed = true;
+        if(!infeasible && substituteSingletonColumns()) changed = true;
+        if(!infeasible && removeDuplicateColumns()) changed = true;
+    }
+
+    // the last round may have left empty or singleton rows behind
+    if(!infeasible) removeEmptyAndSingletonRows();
+    if(infeasible) return INFEASIBLE;
+
+    bool anyActiveRow = std::find(rowActive.begin(), rowActive.end(), true) != rowActive.end();
+    if(!anyActiveRow) {
+        // without rows, every variable is set to the bound favored by the objective function
+        for(uint j = 0; j < nColumns; j++) {
+            if(!colActive[j]) continue;
+            if(cost[j] < 0 && std::isinf(impliedUpper[j])) return UNBOUNDED;
+            fixColumn(j, (cost[j] < 0) ? impliedUpper[j] : impliedLower[j]);
+        }
+    }
+
+    finalizeColumns();
+    return NOT_YET_SOLVED;
+}
+
+LpProblem Presolver::getReducedProblem() {
+    const std::vector<uint>& map = postsolveStack.getColumnMap();
+    const std::vector<double>& offsets = postsolveStack.getColumnOffsets();
+    uint nReduced = map.size();
+
+    if(nReduced == 0) {
+        throw std::invalid_argument("Error using getReducedProblem: presolve removed all the variables of the model");
+    }
+
+    std::vector<int> originalToReduced(nColumns, -1);
+    std::vector<double> objectiveFunction(nReduced);
+    for(uint r = 0; r < nReduced; r++) {
+        originalToReduced[map[r]] = r;
+        objectiveFunction[r] = objectiveSign * cost[map[r]];
+    }
+
+    std::vector<Constraint> constraints;
+    auto addConstraint = [&](std::vector<double> lhs, std::string constraintType, double rhs) {
+        Constraint newConstraint(lhs, constraintType, rhs);
+        newConstraint.normalizeRhs();
+        constraints.push_back(newConstraint);
+    };
+
+    for(uint i = 0; i < nRows; i++) {
+        if(!rowActive[i]) continue;
+
+        std::vector<double> lhs(nReduced, 0.0);
+        double shift = 0;
+        for(const std::pair<uint, double>& entry : rows[i]) {
+            lhs[originalToReduced[entry.first]] = entry.second;
+            shift += entry.second * impliedLower[entry.first];
+        }
+
+        double lower = rowLower[i] - shift;
+        double upper = rowUpper[i] - shift;
+        if(!std::isinf(lower) && !std::isinf(upper) && upper - lower <= PRESOLVE_TOLERANCE) {
+            addConstraint(lhs, "=", lower);
+            continue;
+        }
+        if(!std::isinf(upper)) addConstraint(lhs, "<=", upper);
+        if(!std::isinf(lower)) addConstraint(lhs, ">=", lower);
+    }
+
+    LpProblem reducedProblem(type, objectiveFunction, constraints);
+    // its objective function values(e.g. of dumped models) are the original ones
+    reducedProblem.setObjectiveOffset(postsolveStack.getObjectiveOffset());
+
+    // lower bounds were shifted out, upper bounds which were already part of the model are kept
+    for(uint r = 0; r < nReduced; r++) {
+        uint j = map[r];
+        if(!std::isinf(colUpper[j])) reducedProblem.setVariableBounds(r, 0, impliedUpper[j] - offsets[r]);
+    }
+
+    return reducedProblem;
+}
@@ -0,0 +1,126 @@
+#include "progress.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+// how long the reporter waits for the search to answer its request, before it prints the last snapshot it has(e.g. while a long
+// node LP is solved)
+const double SNAPSHOT_WAIT = 0.2;
+
+// `value` in at most 8 characters, or - if it's NAN
+std::string formatValue(double value) {
+    if(std::isnan(value)) return "-";
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+}
+
+// PRIVATE METHODS
+
+bool ProgressReporter::readSnapshot(ProgressSnapshot& snapshot) {
+    while(true) {
+        uint64_t before = sequence.load(std::memory_order_acquire);
+        if(before == 0) return false;
+        if(before % 2 == 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        snapshot.time = time.load(std::memory_order_relaxed);
+        snapshot.exploredNodes = exploredNodes.load(std::memory_order_relaxed);
+        snapshot.openNodes = openNodes.load(std::memory_order_relaxed);
+        snapshot.lpIterations = lpIterations.load(std::memory_order_relaxed);
+        snapshot.incumbent = incumbent.load(std::memory_order_relaxed);
+        snapshot.bound = bound.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+}
+
+void ProgressReporter::printLine(const ProgressSnapshot& snapshot, double elapsed) {
+    double nodeRate = (snapshot.time > 0) ? snapshot.exploredNodes / snapshot.time : 0;
+    double iterationsPerNode = (snapshot.exploredNodes > 0) ? (double)snapshot.lpIterations / snapshot.exploredNodes : 0;
+
+    std::string gap = "-";
+    if(!std::isnan(snapshot.incumbent) && !std::isnan(snapshot.bound)) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.2f %%", 100 * std::fabs(snapshot.bound - snapshot.incumbent) / std::max(std::fabs(snapshot.incumbent), 1e-10));
+        gap = text;
+    }
+
+    std::fprintf(stderr, "[%8.1f s] nodes %8u  open %6u  %9.1f nodes/s  incumbent %10s  bound %10s  gap %9s  %6.1f it/node\n", elapsed,
+                 snapshot.exploredNodes, snapshot.openNodes, nodeRate, formatValue(snapshot.incumbent).c_str(), formatValue(snapshot.bound).c_str(),
+                 gap.c_str(), iterationsPerNode);
+}
+
+void ProgressReporter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!wakeUp.wait_for(lock, std::chrono::duration<double>(interval), [this]() { return stopping; })) {
+        uint64_t lastSequence = sequence.load(std::memory_order_acquire);
+        requested.store(true, std::memory_order_relaxed);
+
+        // the search answers between two of its iterations
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(std::min(SNAPSHOT_WAIT, interval / 2));
+        while(sequence.load(std::memory_order_acquire) == lastSequence && std::chrono::steady_clock::now() < deadline) {
+            if(wakeUp.wait_for(lock, std::chrono::milliseconds(5), [this]() { return stopping; })) return;
+        }
+
+        ProgressSnapshot snapshot;
+        if(readSnapshot(snapshot)) printLine(snapshot, std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+    }
+}
+
+// PUBLIC METHODS
+
+ProgressReporter::ProgressReporter(double intervalSeconds) : requested(false), sequence(0), time(0), exploredNodes(0), openNodes(0), lpIterations(0),
+                                                             incumbent(NAN), bound(NAN) {
+    interval = intervalSeconds;
+    stopping = false;
+}
+
+ProgressReporter::~ProgressReporter() {
+    stop();
+}
+
+void ProgressReporter::start() {
+    if(thread.joinable()) return;
+
+    startTime = std::chrono::steady_clock::now();
+    stopping = false;
+    thread = std::thread(&ProgressReporter::run, this);
+}
+
+void ProgressReporter::stop() {
+    if(!thread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    thread.join();
+}
+
+void ProgressReporter::publish(const ProgressSnapshot& snapshot) {
+    requested.store(false, std::memory_order_relaxed);
+
+    uint64_t current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    time.store(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count(), std::memory_order_relaxed);
+    exploredNodes.store(snapshot.exploredNodes, std::memory_order_relaxed);
+    openNodes.store(snapshot.openNodes, std::memory_order_relaxed);
+    lpIterations.store(snapshot.lpIterations, std::memory_order_relaxed);
+    incumbent.store(snapshot.incumbent, std::memory_order_relaxed);
+    bound.store(snapshot.bound, std::memory_order_relaxed);
+
+    sequence.store(current + 2, std::memory_order_release);
+}
@@ -0,0 +1,132 @@
+#include "result_cache.h"
+
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace {
+
+std::string formatDouble(double value) {
+    char digits[32];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    return std::string(digits, result.ptr - digits);
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+}
+
+// PRIVATE METHODS
+
+std::string ResultCache::getEntryFileName(const std::string& key) {
+    return directory + "/" + key + ".result";
+}
+
+// PUBLIC METHODS
+
+ResultCache::ResultCache(const std::string& cacheDirectory) {
+    directory = cacheDirectory;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if(error) throw std::invalid_argument("Cannot create the result cache directory " + directory + ": " + error.message());
+}
+
+std::string ResultCache::defaultDirectory() {
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    if(cacheHome != NULL && cacheHome[0] != '\0') return std::string(cacheHome) + "/linsolve";
+
+    const char* home = std::getenv("HOME");
+    if(home != NULL && home[0] != '\0') return std::string(home) + "/.cache/linsolve";
+
+    return "";
+}
+
+std::string ResultCache::getSolverVersion() {
+    static const std::string version = []() {
+        uint64_t buildId;
+        struct stat executable;
+        if(stat("/proc/self/exe", &executable) == 0) {
+            buildId = ((uint64_t)executable.st_size << 32) ^ ((uint64_t)executable.st_mtim.tv_sec * 1000000000ull + executable.st_mtim.tv_nsec);
+        }
+        else buildId = std::hash<std::string>()(__DATE__ " " __TIME__);
+
+        std::ostringstream text;
+        text << RESULT_CACHE_VERSION << "." << std::hex << buildId;
+        return text.str();
+    }();
+    return version;
+}
+
+bool ResultCache::lookup(const std::string& key, uint64_t modelCheck, CachedResult& result) {
+    std::ifstream file(getEntryFileName(key));
+    if(!file) return false;
+
+    // every field is a "name value" line, and the solution line holds the number of values followed by the values
+    std::string name, storedKey, value;
+    uint version, status, rootAlgorithm, nValues;
+    uint64_t storedCheck;
+    double number;
+    if(!(file >> name >> version) || name != "version" || version != RESULT_CACHE_VERSION) return false;
+    if(!(file >> name >> storedKey) || name != "key" || storedKey != key) return false;
+    if(!(file >> name >> std::hex >> storedCheck >> std::dec) || name != "check" || storedCheck != modelCheck) return false;
+    if(!(file >> name >> status) || name != "status" || status > UNBOUNDED) return false;
+    result.status = (ProblemStatus)status;
+
+    if(!(file >> name >> value) || name != "bound" || !parseDouble(value, result.bound)) return false;
+    if(!(file >> name >> result.metrics.explored_nodes) || name != "explored_nodes") return false;
+    if(!(file >> name >> value) || name != "execution_time" || !parseDouble(value, result.metrics.execution_time)) return false;
+    if(!(file >> name >> result.metrics.optimalSolutionDepth) || name != "depth") return false;
+    if(!(file >> name >> result.metrics.lp_iterations) || name != "lp_iterations") return false;
+    if(!(file >> name >> rootAlgorithm) || name != "root_algorithm" || rootAlgorithm > BARRIER) return false;
+    result.metrics.root_algorithm = (LpAlgorithm)rootAlgorithm;
+
+    if(!(file >> name >> nValues) || name != "solution" || nValues == 0) return false;
+    std::vector<double> solution(nValues);
+    for(uint j = 0; j < nValues; j++) {
+        if(!(file >> value) || !parseDouble(value, number)) return false;
+        solution[j] = number;
+    }
+    result.metrics.optimalWholeSolution = Matrix(solution, 1, nValues);
+
+    return true;
+}
+
+void ResultCache::store(const std::string& key, uint64_t modelCheck, const CachedResult& result) {
+    std::ostringstream entry;
+    entry << "version " << RESULT_CACHE_VERSION << "\n";
+    entry << "key " << key << "\n";
+    entry << "check " << std::hex << modelCheck << std::dec << "\n";
+    entry << "status " << result.status << "\n";
+    entry << "bound " << formatDouble(result.bound) << "\n";
+    entry << "explored_nodes " << result.metrics.explored_nodes << "\n";
+    entry << "execution_time " << formatDouble(result.metrics.execution_time) << "\n";
+    entry << "depth " << result.metrics.optimalSolutionDepth << "\n";
+    entry << "lp_iterations " << result.metrics.lp_iterations << "\n";
+    entry << "root_algorithm " << result.metrics.root_algorithm << "\n";
+
+    Matrix solution = result.metrics.optimalWholeSolution;
+    entry << "solution " << solution.getNColumns();
+    for(uint j = 0; j < solution.getNColumns(); j++) entry << " " << formatDouble(solution.getElement(0, j));
+    entry << "\n";
+
+    std::string fileName = getEntryFileName(key);
+    // the temporary name is unique to the process, since other processes may be storing the same result
+    std::string temporaryName = fileName + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream file(temporaryName, std::ios::trunc);
+        if(!file || !(file << entry.str())) throw std::invalid_argument("Cannot write the result cache entry " + temporaryName);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryName, fileName, error);
+    if(error) throw std::invalid_argument("Cannot rename " + temporaryName + " to " + fileName);
+}
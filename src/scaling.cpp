@@ -0,0 +1,144 @@
+#include "scaling.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+double nearestPowerOfTwo(double value) {
+    return std::exp2(std::round(std::log2(value)));
+}
+
+}
+
+double scalingQuality(LpProblem& problem) {
+    double minValue = INFINITY, maxValue = 0;
+
+    for(Constraint& currentConstraint : problem.getConstraints()) {
+        for(double coefficient : currentConstraint.getLhs()) {
+            if(coefficient == 0) continue;
+            minValue = std::min(minValue, std::fabs(coefficient));
+            maxValue = std::max(maxValue, std::fabs(coefficient));
+        }
+    }
+
+    if(maxValue == 0) return 1;
+    return maxValue / minValue;
+}
+
+ScalingFactors computeScalingFactors(LpProblem& problem) {
+    std::vector<Constraint>& constraints = problem.getConstraints();
+    uint nRows = constraints.size();
+    uint nColumns = problem.getObjectiveFunction().getNColumns();
+
+    ScalingFactors factors;
+    factors.rowScale.assign(nRows, 1.0);
+    factors.columnScale.assign(nColumns, 1.0);
+    factors.qualityBefore = scalingQuality(problem);
+
+    std::vector<double> columnMin(nColumns), columnMax(nColumns);
+    double previousQuality = factors.qualityBefore;
+
+    for(uint pass = 0; pass < GEOMETRIC_SCALING_PASSES; pass++) {
+        // rows
+        for(uint i = 0; i < nRows; i++) {
+            std::vector<double>& lhs = constraints[i].getLhs();
+            double minValue = INFINITY, maxValue = 0;
+            for(uint j = 0; j < nColumns; j++) {
+                if(lhs[j] == 0) continue;
+                double value = std::fabs(lhs[j]) * factors.rowScale[i] * factors.columnScale[j];
+                minValue = std::min(minValue, value);
+                maxValue = std::max(maxValue, value);
+            }
+            if(maxValue > 0) factors.rowScale[i] /= std::sqrt(minValue * maxValue);
+        }
+
+        // columns
+        std::fill(columnMin.begin(), columnMin.end(), INFINITY);
+        std::fill(columnMax.begin(), columnMax.end(), 0.0);
+        for(uint i = 0; i < nRows; i++) {
+            std::vector<double>& lhs = constraints[i].getLhs();
+            for(uint j = 0; j < nColumns; j++) {
+                if(lhs[j] == 0) continue;
+                double value = std::fabs(lhs[j]) * factors.rowScale[i] * factors.columnScale[j];
+                columnMin[j] = std::min(columnMin[j], value);
+                columnMax[j] = std::max(columnMax[j], value);
+            }
+        }
+        for(uint j = 0; j < nColumns; j++) {
+            if(columnMax[j] > 0) factors.columnScale[j] /= std::sqrt(columnMin[j] * columnMax[j]);
+        }
+
+        // stop once a pass doesn't improve the spread of the coefficients noticeably
+        double quality = 1, minValue = INFINITY, maxValue = 0;
+        for(uint j = 0; j < nColumns; j++) {
+            if(columnMax[j] == 0) continue;
+            minValue = std::min(minValue, columnMin[j]);
+            maxValue = std::max(maxValue, columnMax[j]);
+        }
+        if(maxValue > 0) quality = maxValue / minValue;
+        if(quality > 0.9 * previousQuality) break;
+        previousQuality = quality;
+    }
+
+    // equilibration: the largest coefficient of every column, and then of every row, becomes 1
+    std::fill(columnMax.begin(), columnMax.end(), 0.0);
+    for(uint i = 0; i < nRows; i++) {
+        std::vector<double>& lhs = constraints[i].getLhs();
+        for(uint j = 0; j < nColumns; j++) {
+            columnMax[j] = std::max(columnMax[j], std::fabs(lhs[j]) * factors.rowScale[i] * factors.columnScale[j]);
+        }
+    }
+    for(uint j = 0; j < nColumns; j++) {
+        if(columnMax[j] > 0) factors.columnScale[j] = nearestPowerOfTwo(factors.columnScale[j] / columnMax[j]);
+    }
+    for(uint i = 0; i < nRows; i++) {
+        std::vector<double>& lhs = constraints[i].getLhs();
+        double maxValue = 0;
+        for(uint j = 0; j < nColumns; j++) maxValue = std::max(maxValue, std::fabs(lhs[j]) * factors.rowScale[i] * factors.columnScale[j]);
+        factors.rowScale[i] = (maxValue > 0) ? nearestPowerOfTwo(factors.rowScale[i] / maxValue) : 1.0;
+    }
+
+    double minValue = INFINITY, maxValue = 0;
+    for(uint i = 0; i < nRows; i++) {
+        std::vector<double>& lhs = constraints[i].getLhs();
+        for(uint j = 0; j < nColumns; j++) {
+            if(lhs[j] == 0) continue;
+            double value = std::fabs(lhs[j]) * factors.rowScale[i] * factors.columnScale[j];
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+    }
+    factors.qualityAfter = (maxValue > 0) ? maxValue / minValue : 1.0;
+
+    // well scaled models are left alone, since rounding the factors to powers of 2 could make them slightly worse
+    if(factors.qualityAfter >= factors.qualityBefore) {
+        std::fill(factors.rowScale.begin(), factors.rowScale.end(), 1.0);
+        std::fill(factors.columnScale.begin(), factors.columnScale.end(), 1.0);
+        factors.qualityAfter = factors.qualityBefore;
+    }
+
+    return factors;
+}
+
+void applyScaling(LpProblem& problem, const ScalingFactors& factors) {
+    std::vector<Constraint>& constraints = problem.getConstraints();
+    Matrix& objectiveFunction = problem.getObjectiveFunction();
+    uint nColumns = objectiveFunction.getNColumns();
+
+    for(uint i = 0; i < constraints.size(); i++) {
+        std::vector<double>& lhs = constraints[i].getLhs();
+        for(uint j = 0; j < nColumns; j++) lhs[j] *= factors.rowScale[i] * factors.columnScale[j];
+        constraints[i].setRhs(constraints[i].getRhs() * factors.rowScale[i]);
+    }
+
+    for(uint j = 0; j < nColumns; j++) {
+        objectiveFunction.setElement(0, j, objectiveFunction.getElement(0, j) * factors.columnScale[j]);
+    }
+}
+
+void unscaleSolution(Matrix& solution, const ScalingFactors& factors) {
+    for(uint j = 0; j < solution.getNColumns() && j < factors.columnScale.size(); j++) {
+        solution.setElement(0, j, solution.getElement(0, j) * factors.columnScale[j]);
+    }
+}
@@ -0,0 +1,44 @@
+#include "shared_incumbent.h"
+
+// PUBLIC METHODS
+
+SharedIncumbent::SharedIncumbent(ProblemType problemType) {
+    type = problemType;
+    hasSolution = false;
+    value = 0;
+    stopped = false;
+}
+
+bool SharedIncumbent::offer(double newValue, const Matrix& newSolution) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    bool better = !hasSolution || ((type == MAX) ? newValue > value : newValue < value);
+    if(!better) return false;
+
+    hasSolution = true;
+    value = newValue;
+    solution = newSolution;
+    return true;
+}
+
+bool SharedIncumbent::isBetter(double candidateValue) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(!hasSolution) return true;
+    return (type == MAX) ? candidateValue > value : candidateValue < value;
+}
+
+bool SharedIncumbent::hasIncumbent() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hasSolution;
+}
+
+double SharedIncumbent::getValue() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return value;
+}
+
+Matrix SharedIncumbent::getSolution() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return solution;
+}
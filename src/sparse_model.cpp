@@ -0,0 +1,141 @@
+#include "sparse_model.h"
+
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+
+namespace {
+
+void mergeTriplets(SparseModel& model, const std::vector<const TripletBuffer*>& buffers) {
+    uint nColumns = model.objective.size();
+
+    // counting sort of the triplets by column
+    size_t nTriplets = 0;
+    std::vector<uint> start(nColumns + 1, 0);
+    for(const TripletBuffer* buffer : buffers) {
+        for(uint column : buffer->columns) start[column + 1]++;
+        nTriplets += buffer->values.size();
+    }
+    for(uint j = 0; j < nColumns; j++) start[j + 1] += start[j];
+
+    std::vector<uint> next(start.begin(), start.end() - 1);
+    std::vector<std::pair<uint, double>> entries(nTriplets);
+    for(const TripletBuffer* buffer : buffers) {
+        for(size_t k = 0; k < buffer->values.size(); k++) {
+            entries[next[buffer->columns[k]]++] = std::make_pair(buffer->rowOffset + buffer->rows[k], buffer->values[k]);
+        }
+    }
+
+    model.columnStart.assign(1, 0);
+    model.rowIndex.clear();
+    model.values.clear();
+    model.rowIndex.reserve(nTriplets);
+    model.values.reserve(nTriplets);
+
+    for(uint j = 0; j < nColumns; j++) {
+        // the entries of a column are usually in row order already, since models are mostly read one row after another
+        if(!std::is_sorted(entries.begin() + start[j], entries.begin() + start[j + 1])) std::sort(entries.begin() + start[j], entries.begin() + start[j + 1]);
+
+        for(uint k = start[j]; k < start[j + 1]; k++) {
+            if(model.values.size() > model.columnStart[j] && model.rowIndex.back() == entries[k].first) model.values.back() += entries[k].second;
+            else {
+                model.rowIndex.push_back(entries[k].first);
+                model.values.push_back(entries[k].second);
+            }
+        }
+
+        // drop the entries that cancelled out
+        uint kept = model.columnStart[j];
+        for(uint k = model.columnStart[j]; k < model.values.size(); k++) {
+            if(model.values[k] == 0) continue;
+            model.rowIndex[kept] = model.rowIndex[k];
+            model.values[kept++] = model.values[k];
+        }
+        model.rowIndex.resize(kept);
+        model.values.resize(kept);
+
+        model.columnStart.push_back(model.values.size());
+    }
+}
+
+}
+
+SparseModel emptySparseModel() {
+    SparseModel model;
+    model.type = MIN;
+    model.objectiveOffset = 0;
+    model.columnStart = {0};
+    return model;
+}
+
+TripletBuffer emptyTripletBuffer(uint rowOffset) {
+    TripletBuffer triplets;
+    triplets.rowOffset = rowOffset;
+    return triplets;
+}
+
+void setMatrixFromTriplets(SparseModel& model, const std::vector<TripletBuffer>& buffers) {
+    std::vector<const TripletBuffer*> pointers;
+    for(const TripletBuffer& buffer : buffers) pointers.push_back(&buffer);
+    mergeTriplets(model, pointers);
+}
+
+void setMatrixFromTriplets(SparseModel& model, const TripletBuffer& triplets) {
+    mergeTriplets(model, {&triplets});
+}
+
+LpProblem sparseModelToLpProblem(const SparseModel& model) {
+    uint nRows = model.rowTypes.size();
+    uint nColumns = model.objective.size();
+
+    // the rows are only made dense here, once the whole model is known
+    std::vector<std::vector<double>> rows(nRows, std::vector<double>(nColumns, 0.0));
+    for(uint j = 0; j < nColumns; j++) {
+        for(uint k = model.columnStart[j]; k < model.columnStart[j + 1]; k++) rows[model.rowIndex[k]][j] += model.values[k];
+    }
+
+    std::vector<Constraint> constraints;
+    for(uint i = 0; i < nRows; i++) {
+        if(std::isnan(model.ranges[i])) {
+            std::string sign = (model.rowTypes[i] == LESS_THAN_OR_EQUAL) ? "<=" : (model.rowTypes[i] == GREATER_THAN_OR_EQUAL) ? ">=" : "=";
+            constraints.push_back(Constraint(rows[i], sign, model.rhs[i]));
+            continue;
+        }
+
+        // ranged row: lower <= row <= upper
+        double lower, upper, range = model.ranges[i];
+        if(model.rowTypes[i] == LESS_THAN_OR_EQUAL) {
+            lower = model.rhs[i] - std::fabs(range);
+            upper = model.rhs[i];
+        }
+        else if(model.rowTypes[i] == GREATER_THAN_OR_EQUAL) {
+            lower = model.rhs[i];
+            upper = model.rhs[i] + std::fabs(range);
+        }
+        else {
+            lower = (range < 0) ? model.rhs[i] + range : model.rhs[i];
+            upper = (range < 0) ? model.rhs[i] : model.rhs[i] + range;
+        }
+
+        if(lower == upper) constraints.push_back(Constraint(rows[i], "=", lower));
+        else {
+            constraints.push_back(Constraint(rows[i], ">=", lower));
+            constraints.push_back(Constraint(rows[i], "<=", upper));
+        }
+    }
+
+    LpProblem problem(model.type, model.objective, std::move(constraints));
+    problem.setObjectiveOffset(model.objectiveOffset);
+    for(uint j = 0; j < nColumns; j++) {
+        if(std::isinf(model.lowerBounds[j])) {
+            std::ostringstream errorMsg;
+            errorMsg << "Variable " << model.columnNames[j] << " has no finite lower bound, which isn't supported";
+            throw std::invalid_argument(errorMsg.str());
+        }
+        if(model.lowerBounds[j] != 0 || !std::isinf(model.upperBounds[j])) {
+            problem.setVariableBounds(j, model.lowerBounds[j], model.upperBounds[j]);
+        }
+    }
+
+    return problem;
+}
@@ -0,0 +1,68 @@
+#include "statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    double rank = fraction * (sorted.size() - 1);
+    size_t lower = (size_t)std::floor(rank);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+SampleStatistics computeStatistics(std::vector<double> samples) {
+    SampleStatistics statistics = {0, 0, 0, 0, 0, 0};
+    if(samples.empty()) return statistics;
+
+    std::sort(samples.begin(), samples.end());
+    statistics.min = samples.front();
+    statistics.median = percentile(samples, 0.5);
+    statistics.p90 = percentile(samples, 0.9);
+    statistics.p99 = percentile(samples, 0.99);
+
+    for(double sample : samples) statistics.mean += sample;
+    statistics.mean /= samples.size();
+
+    if(samples.size() > 1) {
+        double sumOfSquares = 0;
+        for(double sample : samples) sumOfSquares += (sample - statistics.mean) * (sample - statistics.mean);
+        statistics.stddev = std::sqrt(sumOfSquares / (samples.size() - 1));
+    }
+
+    return statistics;
+}
+
+double mannWhitneyPValue(const std::vector<double>& first, const std::vector<double>& second) {
+    double n1 = first.size(), n2 = second.size(), n = n1 + n2;
+    if(first.empty() || second.empty()) return 1;
+
+    // rank both samples together, tied samples sharing the average of their ranks
+    std::vector<std::pair<double, bool>> combined;
+    for(double sample : first) combined.push_back(std::make_pair(sample, true));
+    for(double sample : second) combined.push_back(std::make_pair(sample, false));
+    std::sort(combined.begin(), combined.end());
+
+    double firstRankSum = 0, tieCorrection = 0;
+    for(size_t i = 0; i < combined.size();) {
+        size_t j = i;
+        while(j < combined.size() && combined[j].first == combined[i].first) j++;
+
+        double averageRank = (i + 1 + j) / 2.0;
+        for(size_t k = i; k < j; k++) {
+            if(combined[k].second) firstRankSum += averageRank;
+        }
+
+        double ties = j - i;
+        tieCorrection += ties * ties * ties - ties;
+        i = j;
+    }
+
+    double u = firstRankSum - n1 * (n1 + 1) / 2;
+    double mean = n1 * n2 / 2;
+    double variance = n1 * n2 / 12 * ((n + 1) - tieCorrection / (n * (n - 1)));
+    if(variance <= 0) return 1;
+
+    double z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+    return std::erfc(z / std::sqrt(2.0));
+}
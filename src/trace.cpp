@@ -0,0 +1,127 @@
+#include "trace.h"
+#include "buffered_writer.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdio>
+
+namespace {
+
+// the events of one thread. Buffers outlive their threads, so the trace can be written after the threads end
+typedef struct {
+    std::vector<TraceEvent> events;     // ring of up to TRACE_RING_SIZE events, grown as they're recorded
+    uint64_t recorded;                  // events ever recorded, the last TRACE_RING_SIZE of which are in the ring
+    uint threadId;
+    std::string threadName;
+}TraceBuffer;
+
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<TraceBuffer>> buffers;
+thread_local TraceBuffer* threadBuffer = NULL;
+
+// the calling thread's buffer, registered by its first event
+TraceBuffer* getThreadBuffer() {
+    if(threadBuffer != NULL) return threadBuffer;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.push_back(std::make_unique<TraceBuffer>());
+    threadBuffer = buffers.back().get();
+    threadBuffer->recorded = 0;
+    threadBuffer->threadId = buffers.size();
+    threadBuffer->threadName = (buffers.size() == 1) ? "main" : "thread " + std::to_string(buffers.size() - 1);
+    return threadBuffer;
+}
+
+// `text` as a JSON string. Names are mostly literals, but thread names may have anything
+std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for(char character : text) {
+        if(character == '"' || character == '\\') escaped += '\\';
+        if((unsigned char)character < 0x20) continue;
+        escaped += character;
+    }
+    return escaped + '"';
+}
+
+// `ns` as the µs of the trace event format, keeping the ns
+std::string formatMicroseconds(uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03llu", (unsigned long long)(ns / 1000), (unsigned long long)(ns % 1000));
+    return text;
+}
+
+}
+
+std::atomic<bool> Tracer::enabled(false);
+std::chrono::steady_clock::time_point Tracer::origin;
+
+void Tracer::start() {
+    if(enabled) return;
+    origin = std::chrono::steady_clock::now();
+    enabled = true;
+}
+
+uint64_t Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void Tracer::record(const TraceEvent& event) {
+    TraceBuffer* buffer = getThreadBuffer();
+    if(buffer->events.size() < TRACE_RING_SIZE) buffer->events.push_back(event);
+    else buffer->events[buffer->recorded % TRACE_RING_SIZE] = event;
+    buffer->recorded++;
+}
+
+void Tracer::instant(const char* name, const char* category, const char* argName1, double arg1, const char* argName2, double arg2) {
+    if(!isEnabled()) return;
+    record({name, category, 'i', now(), 0, {argName1, argName2}, {arg1, arg2}});
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    getThreadBuffer()->threadName = name;
+}
+
+void Tracer::write(const std::string& fileName) {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    BufferedWriter writer(fileName);
+    writer << "{\"traceEvents\": [\n";
+
+    bool first = true;
+    uint64_t dropped = 0;
+    for(const std::unique_ptr<TraceBuffer>& buffer : buffers) {
+        writer << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->threadId;
+        writer << ", \"args\": {\"name\": " << jsonString(buffer->threadName) << "}}";
+        first = false;
+
+        uint64_t firstEvent = (buffer->recorded > TRACE_RING_SIZE) ? buffer->recorded - TRACE_RING_SIZE : 0;
+        dropped += firstEvent;
+        for(uint64_t i = firstEvent; i < buffer->recorded; i++) {
+            const TraceEvent& event = buffer->events[i % TRACE_RING_SIZE];
+            writer << ",\n{\"name\": " << jsonString(event.name) << ", \"cat\": " << jsonString(event.category) << ", \"ph\": \"" << event.type << "\"";
+            writer << ", \"ts\": " << formatMicroseconds(event.start);
+            if(event.type == 'X') writer << ", \"dur\": " << formatMicroseconds(event.duration);
+            else writer << ", \"s\": \"t\"";
+            writer << ", \"pid\": 1, \"tid\": " << buffer->threadId;
+
+            if(event.argNames[0] != NULL || event.argNames[1] != NULL) {
+                writer << ", \"args\": {";
+                for(uint k = 0; k < 2; k++) {
+                    if(event.argNames[k] == NULL) continue;
+                    if(k > 0 && event.argNames[0] != NULL) writer << ", ";
+                    writer << jsonString(event.argNames[k]) << ": " << event.args[k];
+                }
+                writer << "}";
+            }
+            writer << "}";
+        }
+
+        // the buffer itself stays registered, as its thread may still be running
+        buffer->events = std::vector<TraceEvent>();
+        buffer->recorded = 0;
+    }
+
+    writer << "\n], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": " << (double)dropped << "}}\n";
+    writer.close();
+}